@@ -96,6 +96,10 @@ delay (2000);
 		rtc.alarmSet(URTCLIB_ALARM_TYPE_1_FIXED_S, 20, 0, 0, 1); // Each minute, at just :20 seconds
 			// RTCLib::alarmSet(uint8_t type, uint8_t second, uint8_t minute, uint8_t hour, uint8_t day_dow);
 
+		// Alternative, any period: wake 7 minutes from now (set on each boot, as MCU is reset). Needs URTCLIB_WITH_WAKE global build flag
+		// rtc.refresh();
+		// rtc.wakeEvery(420);
+
 
 
 		// Go deep sleep:
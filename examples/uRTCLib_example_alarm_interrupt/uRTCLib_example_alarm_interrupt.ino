@@ -0,0 +1,70 @@
+/**
+ * DS1307, DS3231 and DS3232 RTCs basic library
+ *
+ * Really tiny library to basic RTC functionality on Arduino.
+ *
+ * Interrupt driven alarm example (DS3231 and DS3232).
+ *
+ * Connect RTC's INT/SQW pin to an interrupt capable pin (INT_PIN). ISR only marks the edge;
+ * alarmHandle() reads just the status register, clears fired alarm flags and calls their callbacks.
+ *
+ * See uEEPROMLib for EEPROM support.
+ *
+ * @copyright Naguissa
+ * @author Naguissa
+ * @url https://github.com/Naguissa/uRTCLib
+ * @url https://www.foroelectro.net/librerias-arduino-ide-f29/rtclib-arduino-libreria-simple-y-eficaz-para-rtc-y-t95.html
+ * @email naguissa@foroelectro.net
+ */
+#include "Arduino.h"
+#include "uRTCLib.h"
+
+#define INT_PIN 2
+
+uRTCLib rtc(0x68, URTCLIB_MODEL_DS3231);
+
+
+void rtcISR() {
+	rtc.alarmInterrupt();
+}
+
+void everyMinute() {
+	Serial.println("Alarm 1: minute at :30 seconds");
+}
+
+void everyHour() {
+	Serial.println("Alarm 2: hour at :15 minutes");
+}
+
+
+void setup() {
+delay (2000);
+	Serial.begin(9600);
+	Serial.println("Serial OK");
+
+	#ifdef ARDUINO_ARCH_ESP8266
+		URTCLIB_WIRE.begin(0, 2); // D3 and D4 on ESP8266
+	#else
+		URTCLIB_WIRE.begin();
+	#endif
+
+	rtc.alarmSet(URTCLIB_ALARM_TYPE_1_FIXED_S, 30, 0, 0, 1);
+	rtc.alarmSet(URTCLIB_ALARM_TYPE_2_FIXED_M, 0, 15, 0, 1);
+	rtc.alarmCallbackSet(URTCLIB_ALARM_1, everyMinute);
+	rtc.alarmCallbackSet(URTCLIB_ALARM_2, everyHour);
+
+	// Clear old flags so INT goes back high
+	rtc.alarmClearFlag(URTCLIB_ALARM_1);
+	rtc.alarmClearFlag(URTCLIB_ALARM_2);
+
+	if (!rtc.alarmInterruptBegin(INT_PIN, rtcISR)) {
+		Serial.println("INT_PIN has no interrupt, polling only");
+	}
+}
+
+void loop() {
+	rtc.alarmHandle();
+
+	// Polling alternative, 1 byte read:
+	// if (rtc.pollAlarmFlags()) { ... }
+}
@@ -0,0 +1,93 @@
+/**
+ * DS1307, DS3231 and DS3232 RTCs basic library
+ *
+ * Really tiny library to basic RTC functionality on Arduino.
+ *
+ * Bus clock example: bus is kept at 100 kHz for other devices and DS3231/DS3232 transfers run at 400 kHz.
+ * Measures refresh() and RAM block latency with and without clock switching, and the cost of switching itself.
+ *
+ * See uEEPROMLib for EEPROM support.
+ *
+ * @copyright Naguissa
+ * @author Naguissa
+ * @url https://github.com/Naguissa/uRTCLib
+ * @url https://www.foroelectro.net/librerias-arduino-ide-f29/rtclib-arduino-libreria-simple-y-eficaz-para-rtc-y-t95.html
+ * @email naguissa@foroelectro.net
+ */
+#include "Arduino.h"
+#include "uRTCLib.h"
+
+#define BUS_CLOCK 100000
+#define SAMPLES 200
+
+// uRTCLib rtc;
+uRTCLib rtc(0x68);
+
+
+unsigned long measureRefresh() {
+	unsigned long start = micros();
+	for (uint16_t i = 0; i < SAMPLES; i++) {
+		rtc.refresh();
+	}
+	return (micros() - start) / SAMPLES;
+}
+
+unsigned long measureRam() {
+	byte data[32];
+	unsigned long start = micros();
+	for (uint16_t i = 0; i < SAMPLES; i++) {
+		rtc.ramReadBlock(0, data, sizeof(data));
+	}
+	return (micros() - start) / SAMPLES;
+}
+
+unsigned long measureSwitch() {
+	unsigned long start = micros();
+	for (uint16_t i = 0; i < SAMPLES; i++) {
+		URTCLIB_WIRE.setClock(rtc.maxClock());
+		URTCLIB_WIRE.setClock(BUS_CLOCK);
+	}
+	return (micros() - start) / SAMPLES;
+}
+
+void report(const char *name) {
+	Serial.print(name);
+	Serial.print(": refresh() ");
+	Serial.print(measureRefresh());
+	Serial.print(" us, ramReadBlock(32) ");
+	Serial.print(measureRam());
+	Serial.println(" us");
+}
+
+
+void setup() {
+delay (2000);
+	Serial.begin(9600);
+	Serial.println("Serial OK");
+
+	#ifdef ARDUINO_ARCH_ESP8266
+		URTCLIB_WIRE.begin(0, 2); // D3 and D4 on ESP8266
+	#else
+		URTCLIB_WIRE.begin();
+	#endif
+	URTCLIB_WIRE.setClock(BUS_CLOCK);
+
+	rtc.detect();
+	Serial.print("RTC maximum clock: ");
+	Serial.println(rtc.maxClock());
+}
+
+void loop() {
+	rtc.busClock(0); // Never switch
+	report("Bus clock only");
+
+	rtc.busClock(BUS_CLOCK); // Switch around transfers
+	report("Switching to RTC clock");
+
+	Serial.print("setClock() pair overhead: ");
+	Serial.print(measureSwitch());
+	Serial.println(" us");
+	Serial.println();
+
+	delay(5000);
+}
@@ -0,0 +1,63 @@
+/**
+ * DS1307, DS3231 and DS3232 RTCs basic library
+ *
+ * Really tiny library to basic RTC functionality on Arduino.
+ *
+ * Power-outage journal example (DS1307 and DS3232, uses RTC RAM).
+ *
+ * See uEEPROMLib for EEPROM support.
+ *
+ * @copyright Naguissa
+ * @author Naguissa
+ * @url https://github.com/Naguissa/uRTCLib
+ * @url https://www.foroelectro.net/librerias-arduino-ide-f29/rtclib-arduino-libreria-simple-y-eficaz-para-rtc-y-t95.html
+ * @email naguissa@foroelectro.net
+ */
+#include "Arduino.h"
+#include "uRTCLib.h"
+#include "uRTCLibJournal.h"
+
+uRTCLib rtc(0x68, URTCLIB_MODEL_DS3232);
+uRTCLibJournal journal(rtc);
+
+
+void setup() {
+delay (2000);
+	Serial.begin(9600);
+	Serial.println("Serial OK");
+
+	#ifdef ARDUINO_ARCH_ESP8266
+		URTCLIB_WIRE.begin(0, 2); // D3 and D4 on ESP8266
+	#else
+		URTCLIB_WIRE.begin();
+	#endif
+
+	if (journal.begin()) {
+		Serial.print("Outage detected, seconds: ");
+		if (journal.lastOutage() == URTCLIB_JOURNAL_UNKNOWN) {
+			Serial.println("unknown, RTC lost power");
+			// Set time here and clear the flag, so next RTC power loss is recorded as a new outage
+			// rtc.set(0, 0, 12, 1, 1, 1, 24);
+			// rtc.lostPowerClear();
+		} else {
+			Serial.println(journal.lastOutage());
+		}
+	}
+
+	Serial.print("Total outages: ");
+	Serial.println(journal.outages());
+
+	uint32_t start, duration;
+	for (uint8_t i = 0; journal.outage(i, &start, &duration); i++) {
+		Serial.print(" - Start: ");
+		Serial.print(start);
+		Serial.print(" Duration: ");
+		Serial.println(duration);
+	}
+}
+
+void loop() {
+	rtc.refresh();
+	journal.heartbeat(); // Writes only once each URTCLIB_JOURNAL_PERIOD seconds
+	delay(1000);
+}
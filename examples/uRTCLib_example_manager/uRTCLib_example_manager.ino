@@ -0,0 +1,61 @@
+/**
+ * DS1307, DS3231 and DS3232 RTCs basic library
+ *
+ * Really tiny library to basic RTC functionality on Arduino.
+ *
+ * Multi-RTC manager example: primary RTC at 0x68 and backup RTC at 0x69 (change as needed).
+ * Each loop refreshes one RTC only; time() uses cached data from the healthy ones.
+ *
+ * See uEEPROMLib for EEPROM support.
+ *
+ * @copyright Naguissa
+ * @author Naguissa
+ * @url https://github.com/Naguissa/uRTCLib
+ * @url https://www.foroelectro.net/librerias-arduino-ide-f29/rtclib-arduino-libreria-simple-y-eficaz-para-rtc-y-t95.html
+ * @email naguissa@foroelectro.net
+ */
+#include "Arduino.h"
+#include "uRTCLib.h"
+#include "uRTCLibManager.h"
+
+
+uRTCLib primary(0x68, URTCLIB_MODEL_DS3231);
+uRTCLib backup(0x69, URTCLIB_MODEL_DS3231);
+uRTCLibManager rtcs;
+
+
+void setup() {
+delay (2000);
+	Serial.begin(9600);
+	Serial.println("Serial OK");
+
+	#ifdef ARDUINO_ARCH_ESP8266
+		URTCLIB_WIRE.begin(0, 2); // D3 and D4 on ESP8266
+	#else
+		URTCLIB_WIRE.begin();
+	#endif
+
+	rtcs.add(primary);
+	rtcs.add(backup);
+}
+
+void loop() {
+	rtcs.poll(1); // One RTC refresh per loop
+
+	Serial.print("Consensus UNIX time: ");
+	Serial.print(rtcs.time());
+	Serial.print(" from RTC #");
+	Serial.print(rtcs.source());
+
+	for (uint8_t i = 0; i < rtcs.count(); i++) {
+		Serial.print(" - RTC #");
+		Serial.print(i);
+		Serial.print(" status: ");
+		Serial.print(rtcs.status(i));
+		Serial.print(" deviation: ");
+		Serial.print(rtcs.deviation(i));
+	}
+	Serial.println();
+
+	delay(1000);
+}
@@ -0,0 +1,53 @@
+/**
+ * DS1307, DS3231 and DS3232 RTCs basic library
+ *
+ * Really tiny library to basic RTC functionality on Arduino.
+ *
+ * MCU oscillator calibration example. Connect RTC's SQW pin to SQW_PIN.
+ *
+ * See uEEPROMLib for EEPROM support.
+ *
+ * @copyright Naguissa
+ * @author Naguissa
+ * @url https://github.com/Naguissa/uRTCLib
+ * @url https://www.foroelectro.net/librerias-arduino-ide-f29/rtclib-arduino-libreria-simple-y-eficaz-para-rtc-y-t95.html
+ * @email naguissa@foroelectro.net
+ */
+#include "Arduino.h"
+#include "uRTCLib.h"
+#include "uRTCLibOscCal.h"
+
+#define SQW_PIN 2
+
+uRTCLib rtc(0x68, URTCLIB_MODEL_DS3231);
+uRTCLibOscCal oscCal(rtc, SQW_PIN);
+
+
+void setup() {
+delay (2000);
+	Serial.begin(9600);
+	Serial.println("Serial OK");
+
+	#ifdef ARDUINO_ARCH_ESP8266
+		URTCLIB_WIRE.begin(0, 2); // D3 and D4 on ESP8266
+	#else
+		URTCLIB_WIRE.begin();
+	#endif
+
+	oscCal.begin(URTCLIB_SQWG_1H);
+
+	// Uncomment to trim internal RC oscillator on AVR (Serial baud rate will change)
+	// oscCal.trim();
+}
+
+void loop() {
+	long error = oscCal.measure();
+	if (error == URTCLIB_OSCCAL_ERROR) {
+		Serial.println("No SQW signal");
+	} else {
+		Serial.print("MCU clock error (ppm): ");
+		Serial.println(error);
+		Serial.print("60000 ms of millis() are really: ");
+		Serial.println(oscCal.correct(60000));
+	}
+}
@@ -0,0 +1,63 @@
+/**
+ * DS1307, DS3231 and DS3232 RTCs basic library
+ *
+ * Really tiny library to basic RTC functionality on Arduino.
+ *
+ * Task scheduler example.
+ *
+ * See uEEPROMLib for EEPROM support.
+ *
+ * @copyright Naguissa
+ * @author Naguissa
+ * @url https://github.com/Naguissa/uRTCLib
+ * @url https://www.foroelectro.net/librerias-arduino-ide-f29/rtclib-arduino-libreria-simple-y-eficaz-para-rtc-y-t95.html
+ * @email naguissa@foroelectro.net
+ */
+#include "Arduino.h"
+#include "uRTCLib.h"
+#include "uRTCLibScheduler.h"
+
+uRTCLib rtc(0x68, URTCLIB_MODEL_DS3231);
+
+
+void backup() {
+	Serial.println("Daily backup, 02:00");
+}
+
+void poll() {
+	Serial.println("Poll sensors, every 10 minutes");
+}
+
+void report() {
+	Serial.println("Weekly report, Mondays 08:30");
+}
+
+uRTCLibTask tasks[] = {
+	{ backup, URTCLIB_TASK_DAILY, URTCLIB_TASK_AT(2, 0, 0) },
+	{ poll, URTCLIB_TASK_EVERY, 600 },
+	{ report, URTCLIB_TASK_WEEKLY, URTCLIB_TASK_AT(8, 30, 0), URTCLIB_WEEKDAY_MONDAY }
+};
+
+uRTCLibScheduler scheduler(rtc, tasks, sizeof(tasks) / sizeof(tasks[0]));
+
+
+void setup() {
+delay (2000);
+	Serial.begin(9600);
+	Serial.println("Serial OK");
+
+	#ifdef ARDUINO_ARCH_ESP8266
+		URTCLIB_WIRE.begin(0, 2); // D3 and D4 on ESP8266
+	#else
+		URTCLIB_WIRE.begin();
+	#endif
+
+	scheduler.begin();
+}
+
+void loop() {
+	unsigned long idle = scheduler.run();
+
+	// Nothing to do until next deadline; sleep or do other work meanwhile
+	delay(idle > 1000 ? 1000 : idle);
+}
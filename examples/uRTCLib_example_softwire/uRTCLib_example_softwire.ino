@@ -0,0 +1,61 @@
+/**
+ * DS1307, DS3231 and DS3232 RTCs basic library
+ *
+ * Really tiny library to basic RTC functionality on Arduino.
+ *
+ * Software I2C example: RTC on any pair of pins, with external pull-ups.
+ *
+ * Pins have to be defined as global build flags, as uRTCLib.cpp is compiled on its own:
+ *     arduino-cli: --build-property "compiler.cpp.extra_flags=-DURTCLIB_SOFTWIRE_SDA=4 -DURTCLIB_SOFTWIRE_SCL=5"
+ *     PlatformIO:  build_flags = -DURTCLIB_SOFTWIRE_SDA=4 -DURTCLIB_SOFTWIRE_SCL=5
+ *
+ * See uEEPROMLib for EEPROM support.
+ *
+ * @copyright Naguissa
+ * @author Naguissa
+ * @url https://github.com/Naguissa/uRTCLib
+ * @url https://www.foroelectro.net/librerias-arduino-ide-f29/rtclib-arduino-libreria-simple-y-eficaz-para-rtc-y-t95.html
+ * @email naguissa@foroelectro.net
+ */
+#include "Arduino.h"
+#include "uRTCLib.h"
+
+#if !defined(URTCLIB_SOFTWIRE_SDA) || !defined(URTCLIB_SOFTWIRE_SCL)
+	#error "Define URTCLIB_SOFTWIRE_SDA and URTCLIB_SOFTWIRE_SCL as global build flags"
+#endif
+
+
+// uRTCLib rtc;
+uRTCLib rtc(0x68);
+
+
+void setup() {
+delay (2000);
+	Serial.begin(9600);
+	Serial.println("Serial OK");
+
+	URTCLIB_WIRE.begin(); // uRTCLibSoftWireBus
+	URTCLIB_WIRE.setClock(rtc.maxClock()); // 400 kHz for DS3231/DS3232, 100 kHz for DS1307
+
+	Serial.print("Detected model: ");
+	Serial.println(rtc.detect());
+}
+
+void loop() {
+	rtc.refresh();
+
+	Serial.print("RTC DateTime: ");
+	Serial.print(rtc.year());
+	Serial.print('/');
+	Serial.print(rtc.month());
+	Serial.print('/');
+	Serial.print(rtc.day());
+	Serial.print(' ');
+	Serial.print(rtc.hour());
+	Serial.print(':');
+	Serial.print(rtc.minute());
+	Serial.print(':');
+	Serial.println(rtc.second());
+
+	delay(1000);
+}
@@ -0,0 +1,56 @@
+/**
+ * DS1307, DS3231 and DS3232 RTCs basic library
+ *
+ * Really tiny library to basic RTC functionality on Arduino.
+ *
+ * Timezone example: RTC is kept in UTC and local time is computed with DST rules from a POSIX TZ string.
+ * Set RTC to UTC once, i.e. with rtc.set() from a UTC source.
+ *
+ * See uEEPROMLib for EEPROM support.
+ *
+ * @copyright Naguissa
+ * @author Naguissa
+ * @url https://github.com/Naguissa/uRTCLib
+ * @url https://www.foroelectro.net/librerias-arduino-ide-f29/rtclib-arduino-libreria-simple-y-eficaz-para-rtc-y-t95.html
+ * @email naguissa@foroelectro.net
+ */
+#include "Arduino.h"
+#include "uRTCLib.h"
+#include "uRTCLibTimezone.h"
+
+
+// uRTCLib rtc;
+uRTCLib rtc(0x68);
+uRTCLibTimezone tz(rtc);
+
+
+void setup() {
+delay (2000);
+	Serial.begin(9600);
+	Serial.println("Serial OK");
+
+	#ifdef ARDUINO_ARCH_ESP8266
+		URTCLIB_WIRE.begin(0, 2); // D3 and D4 on ESP8266
+	#else
+		URTCLIB_WIRE.begin();
+	#endif
+
+	// Central European Time: UTC+1, DST UTC+2 from last Sunday of March 02:00 to last Sunday of October 03:00
+	if (!tz.begin("CET-1CEST,M3.5.0,M10.5.0/3")) {
+		Serial.println("Wrong TZ string");
+	}
+}
+
+void loop() {
+	rtc.refresh();
+
+	Serial.print("UTC: ");
+	Serial.print(rtc.epoch());
+	Serial.print(" - Local: ");
+	Serial.print(tz.now());
+	Serial.print(" - Offset: ");
+	Serial.print(tz.offset(rtc.epoch()));
+	Serial.println(tz.dst(rtc.epoch()) ? " s (DST)" : " s");
+
+	delay(1000);
+}
@@ -0,0 +1,77 @@
+/**
+ * DS1307, DS3231 and DS3232 RTCs basic library
+ *
+ * Really tiny library to basic RTC functionality on Arduino.
+ *
+ * Yield policy example: measures refresh() latency with each policy.
+ *
+ * Yield code is only compiled on ESP8266 and ESP32 by default; on other MCUs define URTCLIB_YIELD_POLICY globally
+ * (i.e. -DURTCLIB_YIELD_POLICY=1) or all policies will show same results.
+ *
+ * See uEEPROMLib for EEPROM support.
+ *
+ * @copyright Naguissa
+ * @author Naguissa
+ * @url https://github.com/Naguissa/uRTCLib
+ * @url https://www.foroelectro.net/librerias-arduino-ide-f29/rtclib-arduino-libreria-simple-y-eficaz-para-rtc-y-t95.html
+ * @email naguissa@foroelectro.net
+ */
+#include "Arduino.h"
+#include "uRTCLib.h"
+
+#define REFRESHES 200
+
+// uRTCLib rtc;
+uRTCLib rtc(0x68);
+
+const char * const names[] = { "none", "transaction", "budget 2000us", "budget 500us" };
+
+
+void measure(const uint8_t policy, const uint16_t budget, const char *name) {
+	unsigned long start, elapsed, worst = 0, total = 0;
+	uint16_t i, errors = 0;
+	rtc.yieldPolicy(policy, budget);
+	for (i = 0; i < REFRESHES; i++) {
+		start = micros();
+		if (!rtc.refresh()) {
+			errors++;
+		}
+		elapsed = micros() - start;
+		total += elapsed;
+		if (elapsed > worst) {
+			worst = elapsed;
+		}
+		yield(); // Let background tasks run between samples, as loop() does
+	}
+	Serial.print(name);
+	Serial.print(": average ");
+	Serial.print(total / REFRESHES);
+	Serial.print(" us, worst ");
+	Serial.print(worst);
+	Serial.print(" us, errors ");
+	Serial.println(errors);
+}
+
+
+void setup() {
+delay (2000);
+	Serial.begin(9600);
+	Serial.println("Serial OK");
+
+	#ifdef ARDUINO_ARCH_ESP8266
+		URTCLIB_WIRE.begin(0, 2); // D3 and D4 on ESP8266
+	#else
+		URTCLIB_WIRE.begin();
+	#endif
+}
+
+void loop() {
+	Serial.println("refresh() latency:");
+	measure(URTCLIB_YIELD_NONE, 0, names[0]);
+	measure(URTCLIB_YIELD_TRANSACTION, 0, names[1]);
+	measure(URTCLIB_YIELD_BUDGET, 2000, names[2]);
+	measure(URTCLIB_YIELD_BUDGET, 500, names[3]);
+	Serial.println();
+
+	delay(5000);
+}
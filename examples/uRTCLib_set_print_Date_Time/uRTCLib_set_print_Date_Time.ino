@@ -122,6 +122,9 @@ void setup() {
 	rtc.set(0, 42, 16, 6, 2, 5, 15);
 	//  RTCLib::set(byte second, byte minute, byte hour, byte dayOfWeek, byte dayOfMonth, byte month, byte year)
 
+	// Alternative for production: set firmware build time, only if RTC lost power or is older than build
+	// rtc.provisionIfUnset();
+
 	if (rtc.lostPower() || rtc.year() < 19) {
 		if (requestDateBySerialAndSet()) {
 			rtc.lostPowerClear();
@@ -0,0 +1,81 @@
+/**
+ * format() and parse() benchmark against snprintf() and sscanf()
+ *
+ * Times URTCLIB_BENCHMARK_RUNS calls of each one with micros() and prints time and CPU cycles per call.
+ * Needs an RTC on the bus, as examples; time is read once at start. Flash cost of each one can be seen commenting
+ * out the other one and comparing build sizes.
+ *
+ * @copyright Naguissa
+ * @author Naguissa
+ * @url https://github.com/Naguissa/uRTCLib
+ * @email naguissa@foroelectro.net
+ */
+#include "Arduino.h"
+#include "uRTCLib.h"
+#include <stdio.h>
+
+#define URTCLIB_BENCHMARK_RUNS 1000
+
+uRTCLib rtc(0x68);
+
+// Keeps results so nothing is optimized out
+volatile uint32_t sink;
+
+// Prints time and cycles per call
+void report(const char *name, const unsigned long elapsed) {
+	Serial.print(name);
+	Serial.print(": ");
+	Serial.print((float) elapsed / URTCLIB_BENCHMARK_RUNS);
+	Serial.print(" us, ");
+	Serial.print((float) elapsed * (F_CPU / 1000000UL) / URTCLIB_BENCHMARK_RUNS, 0);
+	Serial.println(" cycles");
+}
+
+void setup() {
+	char buffer[URTCLIB_FORMAT_LENGTH];
+	uint8_t data[7];
+	unsigned int year, month, day, hour, minute, second;
+	unsigned long start;
+	uint16_t i;
+
+	delay (2000);
+	Serial.begin(9600);
+	Serial.println("Serial OK");
+
+	#ifdef ARDUINO_ARCH_ESP8266
+		URTCLIB_WIRE.begin(0, 2); // D3 and D4 on ESP8266
+	#else
+		URTCLIB_WIRE.begin();
+	#endif
+	rtc.refresh();
+
+	start = micros();
+	for (i = 0; i < URTCLIB_BENCHMARK_RUNS; i++) {
+		sink += rtc.format(buffer);
+	}
+	report("format()", micros() - start);
+	Serial.println(buffer);
+
+	start = micros();
+	for (i = 0; i < URTCLIB_BENCHMARK_RUNS; i++) {
+		sink += snprintf(buffer, sizeof(buffer), "20%02u-%02u-%02uT%02u:%02u:%02u", rtc.year(), rtc.month(), rtc.day(), rtc.hour(), rtc.minute(), rtc.second());
+	}
+	report("snprintf()", micros() - start);
+	Serial.println(buffer);
+
+	start = micros();
+	for (i = 0; i < URTCLIB_BENCHMARK_RUNS; i++) {
+		sink += uRTCLib::parse(buffer, data);
+	}
+	report("parse()", micros() - start);
+
+	// No validation and no day of week, parse() does both
+	start = micros();
+	for (i = 0; i < URTCLIB_BENCHMARK_RUNS; i++) {
+		sink += sscanf(buffer, "%4u-%2u-%2uT%2u:%2u:%2u", &year, &month, &day, &hour, &minute, &second);
+	}
+	report("sscanf()", micros() - start);
+}
+
+void loop() {
+}
@@ -0,0 +1,57 @@
+#!/bin/sh
+# Flash/RAM footprint report of each URTCLIB_NO_XXX and URTCLIB_WITH_XXX feature flag
+#
+# Compiles extras/size_report/size_report.ino with arduino-cli for each board and flag set and prints
+# .text, .data and .bss of the resulting ELF (Berkeley format of the core size tool). Differences are against
+# default build: negative for removed features, positive for opt-in ones.
+#
+# Needs arduino-cli with the cores of the boards used, and TinyWireM for ATtiny:
+#   arduino-cli core install arduino:avr ATTinyCore:avr esp32:esp32
+#   arduino-cli lib install TinyWireM
+#
+# Usage: extras/size_report.sh [FQBN...]
+
+LIBRARY=$(cd "$(dirname "$0")/.." && pwd)
+SKETCH="$LIBRARY/extras/size_report"
+BUILD=${TMPDIR:-/tmp}/urtclib_size_report
+
+if [ $# -eq 0 ]; then
+	set -- arduino:avr:uno ATTinyCore:avr:attinyx5:chip=85 esp32:esp32:esp32
+fi
+
+FLAGS="- URTCLIB_NO_ALARMS URTCLIB_NO_TEMP URTCLIB_NO_TEMP_CONV URTCLIB_NO_SQWG URTCLIB_NO_RAM URTCLIB_NO_AGING URTCLIB_NO_32K URTCLIB_NO_12H URTCLIB_NO_DETECT URTCLIB_NO_BUS_CLOCK URTCLIB_NO_POWER_PROFILE ALL URTCLIB_WITH_CHANGES URTCLIB_WITH_PRECISE_SET URTCLIB_WITH_MONOTONIC URTCLIB_WITH_WAKE WITH"
+ALL="-DURTCLIB_NO_ALARMS -DURTCLIB_NO_TEMP -DURTCLIB_NO_SQWG -DURTCLIB_NO_RAM -DURTCLIB_NO_AGING -DURTCLIB_NO_32K -DURTCLIB_NO_12H -DURTCLIB_NO_DETECT -DURTCLIB_NO_BUS_CLOCK -DURTCLIB_NO_POWER_PROFILE"
+WITH="-DURTCLIB_WITH_CHANGES -DURTCLIB_WITH_PRECISE_SET -DURTCLIB_WITH_MONOTONIC -DURTCLIB_WITH_WAKE"
+
+status=0
+for fqbn in "$@"; do
+	props=$(arduino-cli compile -b "$fqbn" --show-properties "$SKETCH" 2>/dev/null)
+	size_tool=$(echo "$props" | sed -n 's/^compiler\.path=//p')$(echo "$props" | sed -n 's/^compiler\.size\.cmd=//p')
+	echo
+	echo "$fqbn"
+	printf '%-26s %8s %8s %8s %8s\n' flag text data bss "text diff"
+	base=
+	for flag in $FLAGS; do
+		case $flag in
+			-) defines= ;;
+			ALL) defines=$ALL ;;
+			WITH) defines=$WITH ;;
+			*) defines=-D$flag ;;
+		esac
+		rm -rf "$BUILD"
+		if ! arduino-cli compile -b "$fqbn" --library "$LIBRARY" --build-path "$BUILD" \
+				--build-property "compiler.cpp.extra_flags=$defines" "$SKETCH" > "$BUILD.log" 2>&1; then
+			printf '%-26s %8s\n' "$flag" FAILED
+			status=1
+			continue
+		fi
+		sizes=$("$size_tool" "$BUILD"/*.elf | tail -n 1)
+		text=$(echo "$sizes" | awk '{ print $1 }')
+		data=$(echo "$sizes" | awk '{ print $2 }')
+		bss=$(echo "$sizes" | awk '{ print $3 }')
+		[ -z "$base" ] && base=$text
+		printf '%-26s %8s %8s %8s %8s\n' "$flag" "$text" "$data" "$bss" $((text - base))
+	done
+done
+rm -rf "$BUILD" "$BUILD.log"
+exit $status
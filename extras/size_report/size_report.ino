@@ -0,0 +1,98 @@
+/**
+ * Footprint reference sketch for extras/size_report.sh
+ *
+ * Uses each feature unless it's disabled with its URTCLIB_NO_XXX build flag, or not enabled with its URTCLIB_WITH_XXX
+ * one, so size differences show the cost of that feature on a sketch that actually uses it.
+ *
+ * @copyright Naguissa
+ * @author Naguissa
+ * @url https://github.com/Naguissa/uRTCLib
+ * @email naguissa@foroelectro.net
+ */
+#include "Arduino.h"
+#include "uRTCLib.h"
+
+uRTCLib rtc(0x68);
+
+// Keeps results so nothing is optimized out
+volatile uint32_t sink;
+
+void setup() {
+	URTCLIB_WIRE.begin();
+	#ifndef URTCLIB_NO_ALARMS
+		rtc.alarmSet(URTCLIB_ALARM_TYPE_1_FIXED_S, 30, 0, 0, 1);
+	#endif
+	#ifndef URTCLIB_NO_SQWG
+		rtc.sqwgSetMode(URTCLIB_SQWG_1H);
+	#endif
+	#ifndef URTCLIB_NO_AGING
+		rtc.agingSet(0);
+	#endif
+	#ifndef URTCLIB_NO_32K
+		rtc.disable32KOut();
+	#endif
+	#ifndef URTCLIB_NO_12H
+		rtc.set_12hour_mode(false);
+	#endif
+	#ifndef URTCLIB_NO_DETECT
+		rtc.detect();
+	#endif
+	#ifndef URTCLIB_NO_BUS_CLOCK
+		rtc.busClock(100000UL);
+	#endif
+	#ifndef URTCLIB_NO_POWER_PROFILE
+		rtc.powerProfileSet(URTCLIB_POWER_BALANCED);
+	#endif
+	#ifndef URTCLIB_NO_MONOTONIC
+		rtc.monotonicBegin();
+	#endif
+	#ifndef URTCLIB_NO_PRECISE_SET
+		rtc.setPrecise(0, 0, 0, 1, 1, 1, 24, micros());
+	#endif
+	#ifndef URTCLIB_NO_WAKE
+		rtc.watchdogBegin(5);
+	#endif
+}
+
+void loop() {
+	rtc.refresh();
+	sink = rtc.epoch();
+	#ifndef URTCLIB_NO_TEMP
+		sink += rtc.temp();
+	#endif
+	#ifndef URTCLIB_NO_TEMP_CONV
+		if (rtc.tempReady() || rtc.tempTimedOut()) {
+			rtc.tempConvert();
+		}
+	#endif
+	#ifndef URTCLIB_NO_CHANGES
+		sink += rtc.changes();
+	#endif
+	#ifndef URTCLIB_NO_MONOTONIC
+		sink += rtc.monotonic();
+	#endif
+	#ifndef URTCLIB_NO_WAKE
+		rtc.watchdogKick();
+	#endif
+	#ifndef URTCLIB_NO_ALARMS
+		if (rtc.alarmTriggered(URTCLIB_ALARM_1)) {
+			rtc.alarmClearFlag(URTCLIB_ALARM_1);
+		}
+	#endif
+	#ifndef URTCLIB_NO_SQWG
+		sink += rtc.sqwgMode();
+	#endif
+	#ifndef URTCLIB_NO_RAM
+		rtc.ramWrite(0, rtc.ramRead(0) + 1);
+	#endif
+	#ifndef URTCLIB_NO_AGING
+		sink += rtc.agingGet();
+	#endif
+	#ifndef URTCLIB_NO_32K
+		sink += rtc.status32KOut();
+	#endif
+	#ifndef URTCLIB_NO_12H
+		sink += rtc.hourModeAndAmPm();
+	#endif
+	delay(1000);
+}
@@ -0,0 +1,39 @@
+/**
+ * Host stub of the Arduino core API used by uRTCLib, for host tests only
+ *
+ * Implemented by sim.cpp (register level bus) or by the test itself (pin level bus).
+ */
+#ifndef URTCLIB_TEST_ARDUINO
+	#define URTCLIB_TEST_ARDUINO
+	#include <stdint.h>
+	#include <stddef.h>
+	#include <string.h>
+	#include <stdlib.h>
+
+	typedef uint8_t byte;
+
+	#define PROGMEM
+	#define HIGH 1
+	#define LOW 0
+	#define INPUT 0
+	#define OUTPUT 1
+	#define INPUT_PULLUP 2
+	#define FALLING 2
+	#define RISING 3
+	#define CHANGE 4
+	#define NOT_AN_INTERRUPT -1
+
+	unsigned long millis();
+	unsigned long micros();
+	void delay(unsigned long);
+	void delayMicroseconds(unsigned int);
+	void yield();
+	int digitalRead(uint8_t);
+	void digitalWrite(uint8_t, uint8_t);
+	void pinMode(uint8_t, uint8_t);
+	int digitalPinToInterrupt(uint8_t);
+	void attachInterrupt(uint8_t, void (*)(), int);
+	void detachInterrupt(uint8_t);
+	void noInterrupts();
+	void interrupts();
+#endif
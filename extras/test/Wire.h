@@ -0,0 +1,28 @@
+/**
+ * Host stub of Wire, for host tests only
+ *
+ * Implemented by sim.cpp on top of a simulated RTC register file.
+ */
+#ifndef URTCLIB_TEST_WIRE
+	#define URTCLIB_TEST_WIRE
+	#include "Arduino.h"
+
+	#ifndef BUFFER_LENGTH
+		#define BUFFER_LENGTH 32
+	#endif
+
+	class TwoWire {
+		public:
+			void begin();
+			void setClock(const uint32_t);
+			void beginTransmission(const int);
+			size_t write(const uint8_t);
+			size_t write(const uint8_t *, const size_t);
+			uint8_t endTransmission(const bool = true);
+			uint8_t requestFrom(const int, const int, const bool = true);
+			int read();
+			int available();
+	};
+
+	extern TwoWire Wire;
+#endif
@@ -0,0 +1,58 @@
+/**
+ * Host version of extras/format_benchmark: format() and parse() against snprintf() and sscanf()
+ *
+ * Not run by run.sh, timing depends on host. Build with optimizations, from library root:
+ *   g++ -std=gnu++11 -O2 -Iextras/test -Isrc extras/test/bench_format.cpp extras/test/sim.cpp src/uRTCLib*.cpp -o bench_format
+ */
+#include <stdio.h>
+#include <chrono>
+#include "sim.h"
+#include "uRTCLib.h"
+
+#define RUNS 5000000L
+
+volatile uint32_t sink;
+
+static void report(const char *name, const std::chrono::steady_clock::time_point start) {
+	double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	printf("%-12s %6.1f ns\n", name, elapsed / RUNS);
+}
+
+int main() {
+	uRTCLib rtc(0x68, URTCLIB_MODEL_DS3231);
+	char buffer[URTCLIB_FORMAT_LENGTH];
+	uint8_t data[7];
+	unsigned int year, month, day, hour, minute, second;
+	std::chrono::steady_clock::time_point start;
+	long i;
+
+	simReset(SIM_DS3231);
+	rtc.set(50, 59, 23, 4, 31, 1, 24);
+	rtc.refresh();
+
+	start = std::chrono::steady_clock::now();
+	for (i = 0; i < RUNS; i++) {
+		sink += rtc.format(buffer);
+	}
+	report("format()", start);
+
+	start = std::chrono::steady_clock::now();
+	for (i = 0; i < RUNS; i++) {
+		sink += snprintf(buffer, sizeof(buffer), "20%02u-%02u-%02uT%02u:%02u:%02u", rtc.year(), rtc.month(), rtc.day(), rtc.hour(), rtc.minute(), rtc.second());
+	}
+	report("snprintf()", start);
+
+	start = std::chrono::steady_clock::now();
+	for (i = 0; i < RUNS; i++) {
+		sink += uRTCLib::parse(buffer, data);
+	}
+	report("parse()", start);
+
+	start = std::chrono::steady_clock::now();
+	for (i = 0; i < RUNS; i++) {
+		sink += sscanf(buffer, "%4u-%2u-%2uT%2u:%2u:%2u", &year, &month, &day, &hour, &minute, &second);
+	}
+	report("sscanf()", start);
+	printf("%s\n", buffer);
+	return 0;
+}
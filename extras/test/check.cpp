@@ -0,0 +1,23 @@
+/**
+ * Check counting for host tests
+ *
+ * See check.h
+ */
+#include <stdio.h>
+#include "check.h"
+
+static int _failures = 0;
+static int _checks = 0;
+
+void simCheck(const bool condition, const char *text, const char *file, const int line) {
+	_checks++;
+	if (!condition) {
+		_failures++;
+		printf("%s:%d: check failed: %s\n", file, line, text);
+	}
+}
+
+int simResult() {
+	printf("%d checks, %d failed\n", _checks, _failures);
+	return _failures ? 1 : 0;
+}
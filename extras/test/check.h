@@ -0,0 +1,18 @@
+/**
+ * Check counting for host tests, shared by register level (sim.cpp) and pin level tests
+ */
+#ifndef URTCLIB_TEST_CHECK
+	#define URTCLIB_TEST_CHECK
+
+	/**
+	 * Counts a check and prints it if it failed
+	 */
+	void simCheck(const bool, const char *, const char *, const int);
+
+	/**
+	 * Prints totals and returns process exit code: 0 if all checks passed
+	 */
+	int simResult();
+
+	#define CHECK(condition) simCheck((condition), #condition, __FILE__, __LINE__)
+#endif
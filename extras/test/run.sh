@@ -0,0 +1,75 @@
+#!/bin/sh
+# Host tests of the library against simulated Arduino core, Wire and RTC
+#
+# Each test is built with library sources, stub Arduino headers of this directory, check.cpp and sim.cpp (register
+# level DS1307 / DS3231 / DS3232 simulation), then run. A test fails on any failed CHECK(). test_softwire.cpp
+# implements Arduino core itself with a pin level I2C bus, to run uRTCLibSoftWire. test_timezone.cpp compares
+# uRTCLibTimezone with host C library localtime_r().
+#
+# Needs a host C++11 compiler (CXX, g++ by default) and glibc.
+#
+# Usage: extras/test/run.sh
+
+TEST=$(cd "$(dirname "$0")" && pwd)
+SRC=$(cd "$TEST/../../src" && pwd)
+BUILD=${TMPDIR:-/tmp}/urtclib_test
+CXX=${CXX:-g++}
+CXXFLAGS="-std=gnu++11 -O1 -Wall -Wextra -I$TEST -I$SRC"
+# Opt-in features, for tests that use them
+WITH="-DURTCLIB_WITH_CHANGES -DURTCLIB_WITH_PRECISE_SET -DURTCLIB_WITH_MONOTONIC -DURTCLIB_WITH_WAKE"
+
+status=0
+
+# Builds and runs a test: name, sources, extra flags
+run() {
+	name=$1
+	sources=$2
+	shift 2
+	if ! $CXX $CXXFLAGS "$@" -o "$BUILD/$name" $sources "$TEST/check.cpp" "$SRC"/*.cpp > "$BUILD/$name.log" 2>&1; then
+		cat "$BUILD/$name.log"
+		printf '%-24s %s\n' "$name" "BUILD FAILED"
+		status=1
+		return
+	fi
+	if "$BUILD/$name" > "$BUILD/$name.out" 2>&1; then
+		printf '%-24s %s\n' "$name" "ok: $(tail -n 1 "$BUILD/$name.out")"
+	else
+		cat "$BUILD/$name.out"
+		printf '%-24s %s\n' "$name" FAILED
+		status=1
+	fi
+}
+
+# Compares outputs of two tests, they must be identical
+same() {
+	if cmp -s "$BUILD/$1.out" "$BUILD/$2.out"; then
+		printf '%-24s %s\n' "$1 = $2" ok
+	else
+		diff "$BUILD/$1.out" "$BUILD/$2.out" | head -n 20
+		printf '%-24s %s\n' "$1 = $2" FAILED
+		status=1
+	fi
+}
+
+rm -rf "$BUILD"
+mkdir -p "$BUILD"
+
+run agingcal "$TEST/test_agingcal.cpp $TEST/sim.cpp"
+run busclock "$TEST/test_busclock.cpp $TEST/sim.cpp" $WITH
+run detect "$TEST/test_detect.cpp $TEST/sim.cpp"
+run journal "$TEST/test_journal.cpp $TEST/sim.cpp"
+run layout "$TEST/test_layout.cpp $TEST/sim.cpp" $WITH
+run layout_packed "$TEST/test_layout.cpp $TEST/sim.cpp" $WITH -DURTCLIB_PACKED
+same layout layout_packed
+run monotonic "$TEST/test_monotonic.cpp $TEST/sim.cpp" $WITH
+run parse "$TEST/test_parse.cpp $TEST/sim.cpp"
+run power "$TEST/test_power.cpp $TEST/sim.cpp"
+run precise "$TEST/test_precise.cpp $TEST/sim.cpp" $WITH -DURTCLIB_YIELD_POLICY=URTCLIB_YIELD_TRANSACTION
+run scheduler "$TEST/test_scheduler.cpp $TEST/sim.cpp"
+run snapshot "$TEST/test_snapshot.cpp $TEST/sim.cpp"
+run softwire "$TEST/test_softwire.cpp" -DURTCLIB_SOFTWIRE_SDA=4 -DURTCLIB_SOFTWIRE_SCL=5
+run tempconv "$TEST/test_tempconv.cpp $TEST/sim.cpp"
+run timezone "$TEST/test_timezone.cpp $TEST/sim.cpp"
+run wake "$TEST/test_wake.cpp $TEST/sim.cpp" $WITH
+
+exit $status
@@ -0,0 +1,257 @@
+/**
+ * Host simulation of Arduino core timing, Wire and DS1307 / DS3231 / DS3232 register file
+ *
+ * See sim.h
+ */
+#include <stdio.h>
+#include <time.h>
+#include "sim.h"
+
+uint8_t simRegs[256];
+uint8_t simModel = SIM_DS3232;
+uint8_t simAddress = 0x68;
+uint8_t simStatusRace = 0;
+int simFailTransaction = 0;
+unsigned long simMicros = 0;
+unsigned long simYieldMicros = 0;
+uint32_t simClock = 100000UL;
+int simClockChanges = 0;
+int simTransactions = 0;
+int simYields = 0;
+uint32_t simLastReadClock = 0;
+uint32_t simLastWriteClock = 0;
+int simRegisterWrites[256];
+bool simTicking = false;
+double simDriftPpm = 0;
+double simRtcMicros = 0;
+
+static double _rtcStamp = 0;
+static uint8_t _pointer = 0;
+static int _txAddress;
+static uint8_t _tx[BUFFER_LENGTH];
+static uint8_t _txLength;
+static bool _txOverflow;
+static uint8_t _rx[BUFFER_LENGTH];
+static uint8_t _rxLength, _rxIndex;
+static int _pins[256];
+
+TwoWire Wire;
+
+static uint8_t _lastRegister() {
+	return simModel == SIM_DS1307 ? 0x3F : (simModel == SIM_DS3231 ? 0x12 : 0xFF);
+}
+
+static uint8_t _bcd(const int value) {
+	return (value / 10) * 16 + value % 10;
+}
+
+static int _dec(const uint8_t value) {
+	return (value >> 4) * 10 + (value & 0x0F);
+}
+
+// Bus time of some bytes (plus address) at current clock, 9 clocks each
+static void _busTime(const int bytes) {
+	simMicros += (unsigned long) (bytes + 1) * 9 * 1000000UL / simClock;
+}
+
+// Time registers from oscillator
+static void _tick() {
+	double elapsed;
+	int8_t aging;
+	time_t t;
+	struct tm *g;
+	if (!simTicking) {
+		return;
+	}
+	elapsed = simMicros - _rtcStamp;
+	_rtcStamp = simMicros;
+	aging = (int8_t) simRegs[0x10];
+	// Positive aging slows oscillator, ~0.1 ppm per LSB
+	simRtcMicros += elapsed * (1 + (simDriftPpm - (simModel == SIM_DS1307 ? 0 : aging) * 0.1) * 1e-6);
+	t = 946684800 + (time_t) (simRtcMicros / 1e6);
+	g = gmtime(&t);
+	simRegs[0] = _bcd(g->tm_sec);
+	simRegs[1] = _bcd(g->tm_min);
+	simRegs[2] = _bcd(g->tm_hour); // 24h mode only while ticking
+	simRegs[3] = g->tm_wday + 1; // Sunday is 1
+	simRegs[4] = _bcd(g->tm_mday);
+	simRegs[5] = _bcd(g->tm_mon + 1);
+	simRegs[6] = _bcd(g->tm_year - 100);
+}
+
+// Oscillator restarts from time registers when they are written
+static void _untick() {
+	struct tm g;
+	if (!simTicking) {
+		return;
+	}
+	memset(&g, 0, sizeof(g));
+	g.tm_sec = _dec(simRegs[0] & 0x7F);
+	g.tm_min = _dec(simRegs[1]);
+	g.tm_hour = _dec(simRegs[2] & 0x3F);
+	g.tm_mday = _dec(simRegs[4]);
+	g.tm_mon = _dec(simRegs[5] & 0x1F) - 1;
+	g.tm_year = _dec(simRegs[6]) + 100;
+	simRtcMicros = (timegm(&g) - 946684800.0) * 1e6;
+	_rtcStamp = simMicros;
+}
+
+void simReset(const uint8_t model) {
+	memset(simRegs, 0, sizeof(simRegs));
+	simModel = model;
+	simAddress = 0x68;
+	simStatusRace = 0;
+	simFailTransaction = 0;
+	simClock = 100000UL;
+	simClockChanges = 0;
+	simTransactions = 0;
+	simYields = 0;
+	simYieldMicros = 0;
+	simLastReadClock = 0;
+	simLastWriteClock = 0;
+	memset(simRegisterWrites, 0, sizeof(simRegisterWrites));
+	simTicking = false;
+	simDriftPpm = 0;
+	simRtcMicros = 0;
+	_rtcStamp = simMicros;
+	_pointer = 0;
+}
+
+unsigned long millis() {
+	return simMicros / 1000;
+}
+
+unsigned long micros() {
+	return ++simMicros; // Time goes on while polling
+}
+
+void delay(const unsigned long ms) {
+	simMicros += ms * 1000;
+}
+
+void delayMicroseconds(const unsigned int us) {
+	simMicros += us;
+}
+
+void yield() {
+	simYields++;
+	simMicros += simYieldMicros;
+}
+
+int digitalRead(const uint8_t pin) {
+	return _pins[pin];
+}
+
+void digitalWrite(const uint8_t pin, const uint8_t value) {
+	_pins[pin] = value;
+}
+
+void pinMode(const uint8_t, const uint8_t) { }
+
+int digitalPinToInterrupt(const uint8_t pin) {
+	return pin;
+}
+
+void attachInterrupt(const uint8_t, void (*)(), const int) { }
+
+void detachInterrupt(const uint8_t) { }
+
+void noInterrupts() { }
+
+void interrupts() { }
+
+
+void TwoWire::begin() { }
+
+void TwoWire::setClock(const uint32_t clock) {
+	simClock = clock;
+	simClockChanges++;
+}
+
+void TwoWire::beginTransmission(const int address) {
+	_txAddress = address;
+	_txLength = 0;
+	_txOverflow = false;
+}
+
+size_t TwoWire::write(const uint8_t data) {
+	if (_txLength >= BUFFER_LENGTH) {
+		_txOverflow = true;
+		return 0;
+	}
+	_tx[_txLength++] = data;
+	return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, const size_t length) {
+	size_t i;
+	for (i = 0; i < length && write(data[i]); i++) { }
+	return i;
+}
+
+uint8_t TwoWire::endTransmission(const bool) {
+	uint8_t i;
+	bool time = false;
+	if (_txOverflow) {
+		return 1;
+	}
+	simTransactions++;
+	simLastWriteClock = simClock;
+	_busTime(_txLength);
+	if (_txAddress != simAddress || simTransactions == simFailTransaction) {
+		return 2;
+	}
+	_tick();
+	if (_txLength == 0) {
+		return 0;
+	}
+	if (simModel != SIM_DS1307 && _txLength > 1) {
+		simRegs[0x0F] |= simStatusRace;
+		simStatusRace = 0;
+	}
+	_pointer = _tx[0];
+	for (i = 1; i < _txLength; i++) {
+		time = time || _pointer < 7;
+		if (simModel != SIM_DS1307 && _pointer == 0x0F) {
+			// OSF, A2F and A1F can only be cleared, BSY is read only
+			simRegs[0x0F] = (_tx[i] & 0b01111000) | (simRegs[0x0F] & (_tx[i] | 0b01111100) & 0b10000111);
+			simRegisterWrites[_pointer]++;
+			_pointer++;
+			continue;
+		}
+		simRegs[_pointer] = _tx[i];
+		simRegisterWrites[_pointer]++;
+		_pointer = _pointer >= _lastRegister() ? 0 : _pointer + 1;
+	}
+	if (time) {
+		_untick();
+	}
+	return 0;
+}
+
+uint8_t TwoWire::requestFrom(const int address, const int quantity, const bool) {
+	uint8_t i;
+	_rxLength = 0;
+	_rxIndex = 0;
+	simTransactions++;
+	simLastReadClock = simClock;
+	if (address != simAddress || simTransactions == simFailTransaction) {
+		_busTime(0);
+		return 0;
+	}
+	_tick();
+	for (i = 0; i < quantity && i < BUFFER_LENGTH; i++) {
+		_rx[_rxLength++] = simRegs[_pointer];
+		_pointer = _pointer >= _lastRegister() ? 0 : _pointer + 1;
+	}
+	_busTime(_rxLength);
+	return _rxLength;
+}
+
+int TwoWire::read() {
+	return _rxIndex < _rxLength ? _rx[_rxIndex++] : -1;
+}
+
+int TwoWire::available() {
+	return _rxLength - _rxIndex;
+}
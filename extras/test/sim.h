@@ -0,0 +1,51 @@
+/**
+ * Host simulation of Arduino core timing, Wire and DS1307 / DS3231 / DS3232 register file
+ *
+ * Register level: each Wire transaction reads or writes the register file with model address wrap-around and
+ * advances simulated time as bus bytes at selected clock would. Optionally, time registers tick from a simulated
+ * oscillator with drift and aging register effect.
+ */
+#ifndef URTCLIB_TEST_SIM
+	#define URTCLIB_TEST_SIM
+	#include "Arduino.h"
+	#include "Wire.h"
+	#include "check.h"
+
+	#define SIM_DS1307 1
+	#define SIM_DS3231 2
+	#define SIM_DS3232 3
+
+	// Register file and device
+	extern uint8_t simRegs[256];
+	extern uint8_t simModel;
+	extern uint8_t simAddress;
+
+	// Status flags (OSF, A2F, A1F) set by device right before next register write lands
+	extern uint8_t simStatusRace;
+	// Number of the transaction (simTransactions value) that device doesn't acknowledge, 0 for none
+	extern int simFailTransaction;
+
+	// Time, micros() / millis() source
+	extern unsigned long simMicros;
+	// Time spent on each yield() call
+	extern unsigned long simYieldMicros;
+
+	// Bus statistics
+	extern uint32_t simClock;
+	extern int simClockChanges;
+	extern int simTransactions;
+	extern int simYields;
+	extern uint32_t simLastReadClock;
+	extern uint32_t simLastWriteClock;
+	extern int simRegisterWrites[256];
+
+	// Oscillator: when ticking, time registers follow simRtcMicros (from 2000-01-01)
+	extern bool simTicking;
+	extern double simDriftPpm;
+	extern double simRtcMicros;
+
+	/**
+	 * Clears registers and statistics and selects model
+	 */
+	void simReset(const uint8_t);
+#endif
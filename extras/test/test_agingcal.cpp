@@ -0,0 +1,46 @@
+/**
+ * uRTCLibAgingCal host test
+ *
+ * Simulated DS3232 running 3 ppm fast, sampled hourly against an exact reference for 14 days: aging must converge
+ * to about 30 LSB (0.1 ppm each) and RTC rate error must end under 2 LSB. Calibration state must survive an MCU
+ * reset and RAM must be written only when estimate changes, not on each sample.
+ */
+#include <stdio.h>
+#include "sim.h"
+#include "uRTCLibAgingCal.h"
+
+int main() {
+	uRTCLib rtc(0x68, URTCLIB_MODEL_DS3232);
+	uRTCLibAgingCal cal(rtc);
+	unsigned long stamp;
+	int hour, saves, samples = 0;
+
+	simReset(SIM_DS3232);
+	simTicking = true;
+	simDriftPpm = 3.0;
+	simRtcMicros = 0.3e6; // RTC 300 ms ahead of reference
+	CHECK(!cal.begin()); // Empty RAM
+	for (hour = 0; hour < 24 * 14; hour++) {
+		simMicros += 3600UL * 1000000UL;
+		stamp = millis(); // Reference is MCU time since 2000-01-01
+		CHECK(cal.sample(946684800UL + stamp / 1000, stamp % 1000, stamp));
+		samples++;
+		if (hour % 24 == 0) {
+			printf("day %2d: samples %d, offset %ld ms, error %ld ppb, aging %d\n", hour / 24, cal.samples(), (long) cal.offset(), (long) cal.ppb(), rtc.agingGet());
+		}
+	}
+	printf("aging %d, last step %d, error %ld ppb\n", rtc.agingGet(), cal.lastStep(), (long) cal.ppb());
+	CHECK(rtc.agingGet() >= 28 && rtc.agingGet() <= 32);
+	CHECK(cal.ppb() > -2 * URTCLIB_AGINGCAL_PPB_PER_LSB && cal.ppb() < 2 * URTCLIB_AGINGCAL_PPB_PER_LSB);
+
+	// State header (magic byte) is written once per save; DS3232 RAM starts at register 0x14
+	saves = simRegisterWrites[0x14 + URTCLIB_AGINGCAL_RAM_ADDRESS];
+	printf("%d samples, %d RAM saves\n", samples, saves);
+	CHECK(saves > 0 && saves < samples / 4);
+
+	// MCU reset: stored samples are restored
+	uRTCLibAgingCal restored(rtc);
+	CHECK(restored.begin());
+	CHECK(restored.samples() > 0 && restored.samples() <= cal.samples());
+	return simResult();
+}
@@ -0,0 +1,54 @@
+/**
+ * Bus clock switching host test
+ *
+ * With busClock() set below maxClock(), multi-register writes run at maxClock() and bus is left at bus clock.
+ * setPrecise() measures transfer time and writes time registers at the same clock.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "sim.h"
+#include "uRTCLib.h"
+
+#define BUS 100000UL
+
+/**
+ * Checks last write ran at device clock and bus is back at bus clock
+ */
+static void checkWrite(const bool ok, const int changes) {
+	CHECK(ok);
+	CHECK(simLastWriteClock == URTCLIB_CLOCK_DS323X);
+	CHECK(simClock == BUS);
+	CHECK(simClockChanges == changes);
+}
+
+int main() {
+	uRTCLib rtc(0x68, URTCLIB_MODEL_DS3231);
+	int changes;
+
+	simReset(SIM_DS3231);
+	URTCLIB_WIRE.setClock(BUS);
+	simClockChanges = 0;
+	rtc.busClock(BUS);
+
+	// Measurement and write at the same clock, a single switch for both
+	CHECK(rtc.setPrecise(0, 0, 0, URTCLIB_WEEKDAY_MONDAY, 1, 1, 24, micros()));
+	printf("setPrecise: read %lu Hz, write %lu Hz, %d clock changes\n", (unsigned long) simLastReadClock, (unsigned long) simLastWriteClock, simClockChanges);
+	CHECK(simLastReadClock == simLastWriteClock);
+	checkWrite(true, 2);
+
+	changes = simClockChanges;
+	checkWrite(rtc.powerProfileSet(URTCLIB_POWER_BBSQW), changes + 4);
+
+	changes = simClockChanges;
+	memset(simRegs, 0, 7); // Older than build image, so image is written
+	simRegs[0x0F] = 0;
+	checkWrite(rtc.provisionIfUnset(), changes + 4);
+
+	CHECK(rtc.refresh());
+	changes = simClockChanges;
+	checkWrite(rtc.wakeEvery(3600), changes + 4);
+
+	changes = simClockChanges;
+	checkWrite(rtc.watchdogBegin(5), changes + 6);
+	return simResult();
+}
@@ -0,0 +1,75 @@
+/**
+ * Model detection host test
+ *
+ * detect() on each simulated model, on RAM contents that look like DS323x temperature, on an absent device and when
+ * the temperature register probe read is not acknowledged.
+ */
+#include <stdio.h>
+#include "sim.h"
+#include "uRTCLib.h"
+
+/**
+ * Resets simulation to given model with a valid time and returns detected model on a fresh instance
+ */
+static uint8_t detectOn(const uint8_t simModel, const uint8_t model) {
+	uRTCLib rtc(0x68, model);
+	uint8_t detected;
+	simReset(simModel);
+	simRegs[0x00] = 0x30;
+	simRegs[0x01] = 0x45;
+	simRegs[0x11] = 0x19;
+	simRegs[0x12] = 0x40;
+	simRegs[0x3F] = 0x3F;
+	detected = rtc.detect();
+	CHECK(rtc.model() == (detected != URTCLIB_MODEL_UNKNOWN ? detected : model));
+	printf("sim model %u: detected %u in %lu us, %d transactions\n", simModel, detected, rtc.detectMicros(), simTransactions);
+	return detected;
+}
+
+int main() {
+	uRTCLib rtc(0x68, URTCLIB_MODEL_DS3231);
+	int transactions;
+
+	CHECK(detectOn(SIM_DS1307, URTCLIB_MODEL_DS3232) == URTCLIB_MODEL_DS1307);
+	CHECK(detectOn(SIM_DS3231, URTCLIB_MODEL_DS1307) == URTCLIB_MODEL_DS3231);
+	CHECK(detectOn(SIM_DS3232, URTCLIB_MODEL_DS1307) == URTCLIB_MODEL_DS3232);
+
+	// DS1307 RAM that passes DS323x temperature LSB check
+	simReset(SIM_DS1307);
+	simRegs[0x00] = 0x30;
+	simRegs[0x01] = 0x45;
+	CHECK(rtc.detect(true) == URTCLIB_MODEL_DS1307);
+
+	// Cached result, no bus traffic
+	transactions = simTransactions;
+	CHECK(rtc.detect() == URTCLIB_MODEL_DS1307);
+	CHECK(simTransactions == transactions);
+
+	// Seconds register is not BCD
+	simRegs[0x00] = 0x7A;
+	CHECK(rtc.detect(true) == URTCLIB_MODEL_UNKNOWN);
+	CHECK(rtc.model() == URTCLIB_MODEL_DS1307);
+
+	// Absent device keeps configured model
+	simReset(SIM_DS3232);
+	simAddress = 0x50;
+	rtc.set_model(URTCLIB_MODEL_DS3231);
+	CHECK(rtc.detect(true) == URTCLIB_MODEL_UNKNOWN);
+	CHECK(rtc.model() == URTCLIB_MODEL_DS3231);
+
+	// Temperature probe read (4th transaction) fails: not taken as DS3232
+	simReset(SIM_DS3232);
+	simRegs[0x00] = 0x30;
+	simRegs[0x01] = 0x45;
+	simFailTransaction = 4;
+	CHECK(rtc.detect(true) == URTCLIB_MODEL_UNKNOWN);
+	CHECK(rtc.model() == URTCLIB_MODEL_DS3231);
+
+	// Same on DS1307: its wrap-around is still found
+	simReset(SIM_DS1307);
+	simRegs[0x00] = 0x30;
+	simRegs[0x01] = 0x45;
+	simFailTransaction = 4;
+	CHECK(rtc.detect(true) == URTCLIB_MODEL_DS1307);
+	return simResult();
+}
@@ -0,0 +1,64 @@
+/**
+ * uRTCLibJournal host test
+ *
+ * Boots of a DS3232 with a timed outage and with RTC lost power flag (OSF) set: an outage of unknown duration is
+ * recorded once while the flag stays set, and again only after it has been cleared.
+ */
+#include <stdio.h>
+#include "sim.h"
+#include "uRTCLibJournal.h"
+
+// New MCU boot: fresh objects over same RTC
+static bool boot(uRTCLibJournal **journal, uRTCLib **rtc) {
+	delete *journal;
+	delete *rtc;
+	*rtc = new uRTCLib(0x68, URTCLIB_MODEL_DS3232);
+	*journal = new uRTCLibJournal(**rtc);
+	return (*journal)->begin();
+}
+
+int main() {
+	uRTCLib *rtc = NULL;
+	uRTCLibJournal *journal = NULL;
+	uint32_t start, duration;
+
+	simReset(SIM_DS3232);
+	simTicking = true;
+	simRtcMicros = 8766.0 * 86400e6; // 2024-01-01 00:00:00
+	CHECK(!boot(&journal, &rtc)); // Journal created
+	CHECK(journal->outages() == 0);
+
+	// Running 10 minutes, then 1 hour off
+	simMicros += 600UL * 1000000UL;
+	CHECK(rtc->refresh() && journal->heartbeat());
+	simMicros += 3600UL * 1000000UL;
+	CHECK(boot(&journal, &rtc));
+	CHECK(journal->outages() == 1);
+	CHECK(journal->lastOutage() >= 3600 && journal->lastOutage() < 3600 + URTCLIB_JOURNAL_PERIOD);
+
+	// RTC loses power too: recorded once, as unknown
+	simRegs[0x0F] |= 0b10000000;
+	CHECK(boot(&journal, &rtc));
+	CHECK(journal->outages() == 2);
+	CHECK(journal->lastOutage() == URTCLIB_JOURNAL_UNKNOWN);
+	CHECK(journal->outage(0, &start, &duration) && duration == URTCLIB_JOURNAL_UNKNOWN);
+	simMicros += 120UL * 1000000UL;
+	CHECK(rtc->refresh() && journal->heartbeat());
+	CHECK(!boot(&journal, &rtc));
+	CHECK(!boot(&journal, &rtc));
+	CHECK(journal->outages() == 2);
+
+	// Flag is cleared after setting time: next RTC power loss is a new outage
+	rtc->lostPowerClear();
+	CHECK(rtc->refresh() && !rtc->lostPower());
+	CHECK(journal->heartbeat());
+	simRegs[0x0F] |= 0b10000000;
+	CHECK(boot(&journal, &rtc));
+	CHECK(journal->outages() == 3);
+	CHECK(journal->outage(1, &start, &duration) && duration == URTCLIB_JOURNAL_UNKNOWN);
+	CHECK(journal->outage(2, &start, &duration) && duration >= 3600 && duration < 3600 + URTCLIB_JOURNAL_PERIOD);
+	printf("outages %d\n", journal->outages());
+	delete journal;
+	delete rtc;
+	return simResult();
+}
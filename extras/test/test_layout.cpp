@@ -0,0 +1,138 @@
+/**
+ * Cached data layout host test
+ *
+ * Decodes every value of every register 0x00h-0x12h, and pseudo-random register images, on each model and dumps
+ * all getters; then does the same with values written by setters. run.sh builds it with and without URTCLIB_PACKED
+ * and both dumps must be identical.
+ */
+#include <stdio.h>
+#include "sim.h"
+#include "uRTCLib.h"
+
+static uint32_t seed = 1;
+
+/**
+ * Deterministic pseudo-random byte, same sequence on every build
+ */
+static uint8_t randomByte() {
+	seed = seed * 1103515245UL + 12345UL;
+	return seed >> 16;
+}
+
+/**
+ * Prints all cached values
+ */
+static void dump(uRTCLib &rtc, const char *what, const int a, const int b) {
+	const uint8_t alarms[] = { URTCLIB_ALARM_1, URTCLIB_ALARM_2 };
+	uint8_t i;
+	printf("%s %d %d: %u %u %u %u %u %u %u %u %lu %u %u %u", what, a, b, rtc.second(), rtc.minute(), rtc.hour(), rtc.dayOfWeek(), rtc.day(), rtc.month(), rtc.year(),
+		rtc.hourModeAndAmPm(), (unsigned long) rtc.epoch(), rtc.lostPower(), rtc.getEOSCFlag(), rtc.model());
+	#ifndef URTCLIB_NO_TEMP
+	printf(" t%d", rtc.temp());
+	#endif
+	#ifndef URTCLIB_NO_AGING
+	printf(" a%d", rtc.agingGet());
+	#endif
+	#ifndef URTCLIB_NO_32K
+	printf(" k%u", rtc.status32KOut());
+	#endif
+	#ifndef URTCLIB_NO_SQWG
+	printf(" q%u", rtc.sqwgMode());
+	#endif
+	#ifndef URTCLIB_NO_POWER_PROFILE
+	printf(" p%u", rtc.powerProfile());
+	#endif
+	#ifndef URTCLIB_NO_CHANGES
+	printf(" c%u", rtc.changes());
+	#endif
+	#ifndef URTCLIB_NO_ALARMS
+	for (i = 0; i < 2; i++) {
+		printf(" A%u %u %u %u %u %u", rtc.alarmMode(alarms[i]), rtc.alarmSecond(alarms[i]), rtc.alarmMinute(alarms[i]), rtc.alarmHour(alarms[i]),
+			rtc.alarmDayDow(alarms[i]), rtc.alarmTriggered(alarms[i]));
+	}
+	#else
+	(void) alarms;
+	(void) i;
+	#endif
+	#ifndef URTCLIB_NO_WAKE
+	printf(" w%u", rtc.watchdogFired());
+	#endif
+	printf("\n");
+}
+
+int main() {
+	const uint8_t models[] = { URTCLIB_MODEL_DS1307, URTCLIB_MODEL_DS3231, URTCLIB_MODEL_DS3232 };
+	const uint8_t base[19] = { 0x30, 0x59, 0x23, 0x07, 0x31, 0x12, 0x99, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x88, 0x00, 0x19, 0x40 };
+	uint8_t m, r, j;
+	int v, images = 0;
+
+	for (m = 0; m < sizeof(models); m++) {
+		uRTCLib rtc(0x68, models[m]);
+		simReset(models[m]);
+
+		// Every value of every register
+		for (r = 0; r < 19; r++) {
+			for (v = 0; v < 256; v++) {
+				for (j = 0; j < 19; j++) {
+					simRegs[j] = base[j];
+				}
+				simRegs[r] = v;
+				CHECK(rtc.refresh());
+				dump(rtc, "reg", r, v);
+				images++;
+			}
+		}
+
+		// Random images
+		for (v = 0; v < 2000; v++) {
+			for (j = 0; j < 19; j++) {
+				simRegs[j] = randomByte();
+			}
+			CHECK(rtc.refresh());
+			dump(rtc, "random", models[m], v);
+			images++;
+		}
+
+		// Setters update cache directly
+		for (v = 0; v < 200; v++) {
+			rtc.set(randomByte() % 60, randomByte() % 60, randomByte() % 24, randomByte() % 7 + 1, randomByte() % 28 + 1, randomByte() % 12 + 1, randomByte() % 100);
+			dump(rtc, "set", models[m], v);
+			#ifndef URTCLIB_NO_12H
+			rtc.set_12hour_mode(true);
+			dump(rtc, "12h", models[m], v);
+			rtc.set_12hour_mode(false);
+			#endif
+		}
+		#ifndef URTCLIB_NO_ALARMS
+		for (v = 0; v < 200; v++) {
+			const uint8_t types[] = { URTCLIB_ALARM_TYPE_1_ALL_S, URTCLIB_ALARM_TYPE_1_FIXED_S, URTCLIB_ALARM_TYPE_1_FIXED_MS,
+				URTCLIB_ALARM_TYPE_1_FIXED_HMS, URTCLIB_ALARM_TYPE_1_FIXED_DHMS, URTCLIB_ALARM_TYPE_1_FIXED_DOWHMS,
+				URTCLIB_ALARM_TYPE_2_ALL_M, URTCLIB_ALARM_TYPE_2_FIXED_M, URTCLIB_ALARM_TYPE_2_FIXED_HM,
+				URTCLIB_ALARM_TYPE_2_FIXED_DHM, URTCLIB_ALARM_TYPE_2_FIXED_DOWHM };
+			rtc.alarmSet(types[v % sizeof(types)], randomByte() % 60, randomByte() % 60, randomByte() % 24, randomByte() % 31 + 1);
+			dump(rtc, "alarm", models[m], v);
+		}
+		#endif
+		#ifndef URTCLIB_NO_SQWG
+		for (v = 0; v < 256; v++) {
+			rtc.sqwgSetMode(v);
+			dump(rtc, "sqwg", models[m], v);
+		}
+		#endif
+		#ifndef URTCLIB_NO_POWER_PROFILE
+		for (v = 0; v < 16; v++) {
+			rtc.powerProfileSet(v);
+			dump(rtc, "power", models[m], v);
+		}
+		#endif
+		#ifndef URTCLIB_NO_WAKE
+		for (v = 0; v < 64; v++) {
+			simRegs[0x0F] = v & 0b00000010;
+			rtc.watchdogBegin(v);
+			dump(rtc, "watchdog", models[m], v);
+		}
+		#endif
+	}
+	printf("%d images\n", images);
+	return simResult();
+}
@@ -0,0 +1,41 @@
+/**
+ * Monotonic counter host test
+ *
+ * Clock set backwards doesn't move monotonic() back; offset survives an MCU reset on DS3232 RAM, and DS3231 (no RAM)
+ * reports no stored offset without any RAM access.
+ */
+#include "sim.h"
+#include "uRTCLib.h"
+
+int main() {
+	uint32_t start;
+	int transactions;
+
+	simReset(SIM_DS3232);
+	simTicking = true;
+	simRtcMicros = 8766.0 * 86400e6 + 36000e6; // 2024-01-01 10:00:00
+	uRTCLib rtc(0x68, URTCLIB_MODEL_DS3232);
+	CHECK(!rtc.monotonicBegin()); // Nothing stored yet
+	CHECK(rtc.refresh());
+	start = rtc.monotonic();
+	simMicros += 30UL * 1000000UL;
+	rtc.set(0, 0, 8, 2, 1, 1, 24); // 2 hours and 30 seconds back
+	CHECK(rtc.refresh());
+	CHECK(rtc.monotonic() - start == 30);
+	CHECK(rtc.monotonicOffset() == 7230);
+
+	uRTCLib restarted(0x68, URTCLIB_MODEL_DS3232);
+	CHECK(restarted.monotonicBegin());
+	CHECK(restarted.monotonicOffset() == 7230);
+
+	simReset(SIM_DS3231);
+	simTicking = true;
+	simRtcMicros = 8766.0 * 86400e6 + 36000e6;
+	uRTCLib ds3231(0x68, URTCLIB_MODEL_DS3231);
+	transactions = simTransactions;
+	CHECK(!ds3231.monotonicBegin());
+	CHECK(simTransactions == transactions);
+	ds3231.set(0, 0, 8, 2, 1, 1, 24);
+	CHECK(ds3231.monotonicOffset() == 7200);
+	return simResult();
+}
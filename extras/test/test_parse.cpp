@@ -0,0 +1,81 @@
+/**
+ * ISO 8601 parser host test
+ *
+ * parse() accepts extended and basic forms with 'T' or space and optional 'Z', computing day of week, and rejects
+ * out of range fields, bad or mixed separators, February 29th of non leap years, 12 hour input and truncated text.
+ * setFromString() doesn't touch RTC on rejected text.
+ */
+#include <stdio.h>
+#include "sim.h"
+#include "uRTCLib.h"
+
+/**
+ * Text and expected set() parameters: second, minute, hour, day of week, day, month, year
+ */
+struct accepted {
+	const char *text;
+	uint8_t data[7];
+};
+
+int main() {
+	const accepted valid[] = {
+		{ "2024-01-31T23:59:50", { 50, 59, 23, URTCLIB_WEEKDAY_WEDNESDAY, 31, 1, 24 } },
+		{ "2024-01-31 23:59:50Z", { 50, 59, 23, URTCLIB_WEEKDAY_WEDNESDAY, 31, 1, 24 } },
+		{ "20240131T235950", { 50, 59, 23, URTCLIB_WEEKDAY_WEDNESDAY, 31, 1, 24 } },
+		{ "20240131 235950Z", { 50, 59, 23, URTCLIB_WEEKDAY_WEDNESDAY, 31, 1, 24 } },
+		{ "2000-01-01T00:00:00", { 0, 0, 0, URTCLIB_WEEKDAY_SATURDAY, 1, 1, 0 } },
+		{ "2000-02-29T12:00:00", { 0, 0, 12, URTCLIB_WEEKDAY_TUESDAY, 29, 2, 0 } },
+		{ "2024-02-29T12:00:00", { 0, 0, 12, URTCLIB_WEEKDAY_THURSDAY, 29, 2, 24 } },
+		{ "2023-04-30T06:07:08", { 8, 7, 6, URTCLIB_WEEKDAY_SUNDAY, 30, 4, 23 } },
+		{ "2099-12-31T23:59:59", { 59, 59, 23, URTCLIB_WEEKDAY_THURSDAY, 31, 12, 99 } }
+	};
+	const char *invalid[] = {
+		// Out of range fields
+		"1999-12-31T23:59:59", "2100-01-01T00:00:00", "2024-00-10T10:00:00", "2024-13-10T10:00:00", "2024-01-00T10:00:00",
+		"2024-01-32T10:00:00", "2024-04-31T10:00:00", "2024-06-31T10:00:00", "2024-01-10T24:00:00", "2024-01-10T10:60:00",
+		"2024-01-10T10:00:60", "20241310T100000",
+		// February 29th of non leap years
+		"2023-02-29T10:00:00", "2100-02-29T10:00:00", "20230229T100000",
+		// Separators
+		"2024/01/10T10:00:00", "2024-01-10t10:00:00", "2024-01-10_10:00:00", "2024-01-10T10.00.00", "2024-01-10T10-00-00",
+		"2024-01-10T100000", "20240110T10:00:00", "202401-10T10:00:00", "2024-0110T10:00:00", "2024-01-10T10:0000",
+		"2024-01-10T10:00:00z", "2024-01-10T10:00:00ZZ", "2024-01-10T10:00:00+01:00", " 2024-01-10T10:00:00",
+		// 12 hour input
+		"2024-01-10 10:00:00 PM", "2024-01-10 10:00:00AM", "2024-01-10 10:00 PM", "20240110 100000PM",
+		// Truncated, non digits
+		"", "2", "20", "202", "2024", "2024-01-10", "2024-01-10T10:00", "2024-01-10T10:00:0", "2024-1-10T10:00:00",
+		"2024-01-10T1a:00:00", "20240110T10000"
+	};
+	uRTCLib rtc(0x68, URTCLIB_MODEL_DS3231);
+	uint8_t data[7];
+	unsigned int i, j;
+	bool same;
+
+	simReset(SIM_DS3231);
+	for (i = 0; i < sizeof(valid) / sizeof(valid[0]); i++) {
+		memset(data, 0xFF, sizeof(data));
+		same = rtc.parse(valid[i].text, data);
+		for (j = 0; j < 7; j++) {
+			same = same && data[j] == valid[i].data[j];
+		}
+		if (!same) {
+			printf("%s: %u %u %u %u %u %u %u\n", valid[i].text, data[0], data[1], data[2], data[3], data[4], data[5], data[6]);
+		}
+		CHECK(same);
+	}
+	for (i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+		if (rtc.parse(invalid[i], data)) {
+			printf("\"%s\" accepted\n", invalid[i]);
+			CHECK(false);
+		}
+	}
+	printf("%u accepted, %u rejected\n", (unsigned int) (sizeof(valid) / sizeof(valid[0])), (unsigned int) (sizeof(invalid) / sizeof(invalid[0])));
+
+	// RTC only written on valid text
+	CHECK(!rtc.setFromString("2023-02-29T10:00:00"));
+	CHECK(simTransactions == 0);
+	CHECK(rtc.setFromString("2024-02-29T10:20:30"));
+	CHECK(simRegs[0x00] == 0x30 && simRegs[0x01] == 0x20 && simRegs[0x02] == 0x10 && simRegs[0x03] == URTCLIB_WEEKDAY_THURSDAY);
+	CHECK(simRegs[0x04] == 0x29 && (simRegs[0x05] & 0b00011111) == 0x02 && simRegs[0x06] == 0x24);
+	return simResult();
+}
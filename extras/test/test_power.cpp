@@ -0,0 +1,39 @@
+/**
+ * DS3231 / DS3232 power profile host test
+ *
+ * powerProfileSet() changes CRATE, BB32kHz and BBSQW bits only: EN32kHz is kept and OSF, A2F and A1F flags are
+ * neither cleared nor lost when they are set between register read and write.
+ */
+#include <stdio.h>
+#include "sim.h"
+#include "uRTCLib.h"
+
+int main() {
+	uRTCLib rtc(0x68, URTCLIB_MODEL_DS3232);
+
+	simReset(SIM_DS3232);
+	simRegs[0x0E] = 0b00011100;
+	simRegs[0x0F] = 0b10001000; // OSF, EN32kHz
+	simStatusRace = 0b00000011; // Both alarms fire meanwhile
+	CHECK(rtc.powerProfileSet(URTCLIB_POWER_MIN_DRAIN));
+	printf("control %02x status %02x\n", simRegs[0x0E], simRegs[0x0F]);
+	CHECK(simRegs[0x0F] == (0b10001011 | ((URTCLIB_POWER_MIN_DRAIN & 0b00000111) << 4)));
+	CHECK((simRegs[0x0E] & 0b01000000) == ((URTCLIB_POWER_MIN_DRAIN & URTCLIB_POWER_BBSQW) << 3));
+	CHECK(rtc.powerProfile() == URTCLIB_POWER_MIN_DRAIN);
+
+	simRegs[0x0F] = 0;
+	CHECK(rtc.powerProfileSet(URTCLIB_POWER_MAX_ACCURACY));
+	CHECK(simRegs[0x0F] == ((URTCLIB_POWER_MAX_ACCURACY & 0b00000111) << 4));
+
+	// DS3231 has only BBSQW, status register is not written
+	simReset(SIM_DS3231);
+	uRTCLib ds3231(0x68, URTCLIB_MODEL_DS3231);
+	simRegs[0x0F] = 0b00001001;
+	simStatusRace = 0b10000010; // Oscillator stops and alarm 2 fires meanwhile
+	CHECK(ds3231.powerProfileSet(URTCLIB_POWER_BBSQW));
+	printf("DS3231 control %02x status %02x\n", simRegs[0x0E], simRegs[0x0F]);
+	CHECK(simRegs[0x0E] & 0b01000000);
+	CHECK(simRegs[0x0F] == 0b10001011);
+	CHECK(ds3231.powerProfile() == URTCLIB_POWER_BBSQW);
+	return simResult();
+}
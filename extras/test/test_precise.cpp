@@ -0,0 +1,30 @@
+/**
+ * setPrecise() host test
+ *
+ * Built with #URTCLIB_YIELD_TRANSACTION: time spent on yields must not be taken as transfer time, so measured
+ * latency is the same whatever yield() costs.
+ */
+#include <stdio.h>
+#include "sim.h"
+#include "uRTCLib.h"
+
+/**
+ * Runs setPrecise() with given yield() cost and returns measured latency
+ */
+static unsigned long latency(const unsigned long yieldMicros) {
+	uRTCLib rtc(0x68, URTCLIB_MODEL_DS3231);
+	simReset(SIM_DS3231);
+	simYieldMicros = yieldMicros;
+	CHECK(rtc.setPrecise(0, 0, 0, URTCLIB_WEEKDAY_MONDAY, 1, 1, 24, micros()));
+	CHECK(simYields > 0); // Policy is still applied out of measurement
+	CHECK(rtc.second() == 1 || rtc.second() == 2);
+	return rtc.setLatency();
+}
+
+int main() {
+	unsigned long base = latency(0), slow = latency(1000);
+	printf("latency %lu us, with 1 ms yields %lu us\n", base, slow);
+	CHECK(base > 0);
+	CHECK(slow == base);
+	return simResult();
+}
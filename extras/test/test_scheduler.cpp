@@ -0,0 +1,58 @@
+/**
+ * uRTCLibScheduler host test
+ *
+ * Three simulated hours from 2023-12-31 23:30 (Sunday) with a 10 minute task, a daily task at 02:00 and a weekly
+ * task on Mondays at 01:00: each deadline instant runs its tasks once and costs one RTC read.
+ */
+#include <stdio.h>
+#include "sim.h"
+#include "uRTCLibScheduler.h"
+
+uRTCLib rtc(0x68, URTCLIB_MODEL_DS3231);
+int everyRuns = 0, dailyRuns = 0, weeklyRuns = 0;
+uint32_t dailyAt = 0;
+
+void every() {
+	CHECK(rtc.epoch() % 600 == 0);
+	everyRuns++;
+}
+
+void daily() {
+	dailyAt = rtc.epoch();
+	dailyRuns++;
+}
+
+void weekly() {
+	weeklyRuns++;
+}
+
+uRTCLibTask tasks[] = {
+	{ every, URTCLIB_TASK_EVERY, 600, 0, 0 },
+	{ daily, URTCLIB_TASK_DAILY, URTCLIB_TASK_AT(2, 0, 0), 0, 0 },
+	{ weekly, URTCLIB_TASK_WEEKLY, URTCLIB_TASK_AT(1, 0, 0), URTCLIB_WEEKDAY_MONDAY, 0 }
+};
+
+int main() {
+	uRTCLibScheduler scheduler(rtc, tasks, 3);
+	int transactions;
+	long i;
+
+	simReset(SIM_DS3231);
+	simTicking = true;
+	simRtcMicros = (8766.0 * 86400 - 1800) * 1e6; // 2023-12-31 23:30:00
+	CHECK(scheduler.begin());
+	transactions = simTransactions;
+	for (i = 0; i < 3 * 3600L * 10; i++) {
+		scheduler.run();
+		simMicros += 100000UL;
+	}
+	// Every 10 minutes from 23:40 to 02:20; weekly and daily ones share 01:00 and 02:00 deadlines
+	CHECK(everyRuns == 17);
+	CHECK(dailyRuns == 1);
+	CHECK(dailyAt % 86400 == 7200);
+	CHECK(weeklyRuns == 1);
+	// One pointer write and one read per deadline instant
+	printf("deadlines %d, RTC transactions %d\n", everyRuns, simTransactions - transactions);
+	CHECK(simTransactions - transactions == 2 * everyRuns);
+	return simResult();
+}
@@ -0,0 +1,58 @@
+/**
+ * Registers snapshot host test
+ *
+ * A DS3232 snapshot is restored over changed configuration and RAM: only differing runs are written, temperature is
+ * skipped and OSF, A2F and A1F set by the device between restore reads and writes are kept.
+ */
+#include <stdio.h>
+#include "sim.h"
+#include "uRTCLib.h"
+
+int main() {
+	uRTCLib rtc(0x68, URTCLIB_MODEL_DS3232);
+	uRTCLib ds3231(0x68, URTCLIB_MODEL_DS3231);
+	uRTCLibSnapshot snapshot, after;
+	int i;
+
+	simReset(SIM_DS3232);
+	for (i = 0x14; i < 0x100; i++) {
+		simRegs[i] = i;
+	}
+	simRegs[0x07] = 0x15;
+	simRegs[0x0E] = 0b00011100;
+	simRegs[0x0F] = 0b00111000; // EN32kHz, CRATE and BB32kHz
+	simRegs[0x11] = 0x19;
+	CHECK(rtc.dumpRegisters(snapshot));
+	CHECK(snapshot.length == 0x100 && snapshot.model == URTCLIB_MODEL_DS3232);
+
+	// Nothing differs, flags alone don't count
+	simRegs[0x0F] |= 0b10000011;
+	CHECK(rtc.restoreRegisters(snapshot) == 0);
+	simRegs[0x0F] = 0b00111000;
+
+	// Alarm, control, status configuration and a RAM byte changed; temperature changed too
+	simRegs[0x07] = 0x20;
+	simRegs[0x0E] = 0b00000100;
+	simRegs[0x0F] = 0b00000000;
+	simRegs[0x11] = 0x22;
+	simRegs[0x80] = 0;
+	memset(simRegisterWrites, 0, sizeof(simRegisterWrites));
+	simStatusRace = 0b10000011; // Oscillator stops and both alarms fire after restore reads
+	i = rtc.restoreRegisters(snapshot);
+	printf("restore wrote %d registers, control %02x status %02x\n", i, simRegs[0x0E], simRegs[0x0F]);
+	CHECK(i == 4);
+	CHECK(simRegs[0x07] == 0x15 && simRegs[0x0E] == 0b00011100 && simRegs[0x80] == 0x80);
+	CHECK(simRegs[0x0F] == 0b10111011);
+	CHECK(simRegs[0x11] == 0x22 && simRegisterWrites[0x11] == 0);
+	CHECK(rtc.lostPower());
+
+	// Remaining differences are flags and temperature only
+	CHECK(rtc.dumpRegisters(after));
+	CHECK(rtc.diffRegisters(snapshot, after) == 0x0F);
+	CHECK(rtc.diffRegisters(snapshot, after, 0x10) == 0x11);
+	CHECK(rtc.diffRegisters(snapshot, after, 0x12) == -1);
+
+	// Other model
+	CHECK(ds3231.restoreRegisters(snapshot) == -1);
+	return simResult();
+}
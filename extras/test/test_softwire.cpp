@@ -0,0 +1,312 @@
+/**
+ * uRTCLibSoftWire pin level host test
+ *
+ * Implements Arduino core with a simulated open drain I2C bus: pinMode() drives lines, pull-ups keep them high
+ * otherwise. A DS3232 slave state machine answers on it, with optional clock stretching. Bus timing is measured
+ * on every SCL edge.
+ *
+ * Built with -DURTCLIB_SOFTWIRE_SDA=4 -DURTCLIB_SOFTWIRE_SCL=5, without sim.cpp.
+ */
+#include <stdio.h>
+#include "check.h"
+#include "uRTCLib.h"
+
+// Simulated time, microseconds
+static double now = 0;
+
+// Lines: low while master pin is OUTPUT, slave drives SDA low or holds SCL low (stretching or stuck bus)
+static bool masterLow[64];
+static bool slaveSda = false;
+static bool sclStuck = false;
+static double stretchUntil = 0;
+static int stretchMicros = 0;
+static bool sda = true;
+static bool scl = true;
+
+// Bus statistics
+static double lastRise = 0;
+static double lastFall = 0;
+static double minHigh;
+static double minLow;
+static int starts = 0;
+static int stops = 0;
+
+// Slave: DS3232 register file and I2C state
+static uint8_t regs[256];
+static uint8_t slaveAddress = 0x68;
+static uint8_t pointer = 0;
+static uint8_t shift = 0;
+static uint8_t out = 0;
+static int state = -1; // 0 address, 1 master writes, 2 master reads
+static int bit = 0;
+static bool addressed = false;
+static bool firstByte = false;
+static bool masterAck = false;
+static bool readMode = false;
+
+static bool sclLevel() {
+	return !(masterLow[URTCLIB_SOFTWIRE_SCL] || now < stretchUntil || sclStuck);
+}
+
+static bool sdaLevel() {
+	return !(masterLow[URTCLIB_SOFTWIRE_SDA] || slaveSda);
+}
+
+/**
+ * Slave puts current bit of output byte on SDA
+ */
+static void slaveDrive() {
+	slaveSda = !((out >> (7 - bit)) & 1);
+}
+
+/**
+ * SCL falling edge: slave changes SDA
+ */
+static void onFall() {
+	if (!addressed) {
+		return;
+	}
+	if (bit < 7) {
+		bit++;
+		if (state == 2) {
+			slaveDrive();
+		}
+	} else if (bit == 7) { // Acknowledge bit
+		bit = 8;
+		if (state == 0) {
+			if ((shift >> 1) == slaveAddress) {
+				readMode = shift & 1;
+				slaveSda = true;
+			} else {
+				addressed = false;
+			}
+		} else if (state == 1) {
+			if (firstByte) {
+				pointer = shift;
+				firstByte = false;
+			} else {
+				regs[pointer++] = shift;
+			}
+			slaveSda = true;
+		} else {
+			slaveSda = false; // Master acknowledges
+		}
+	} else { // Next byte
+		bit = 0;
+		slaveSda = false;
+		if (state == 0) {
+			state = readMode ? 2 : 1;
+			firstByte = true;
+			stretchUntil = now + stretchMicros;
+			if (state == 2) {
+				out = regs[pointer++];
+				slaveDrive();
+			}
+		} else if (state == 2) {
+			if (masterAck) {
+				out = regs[pointer++];
+				slaveDrive();
+			} else {
+				addressed = false;
+			}
+		}
+	}
+}
+
+/**
+ * SCL rising edge: slave samples SDA
+ */
+static void onRise() {
+	if (!addressed) {
+		return;
+	}
+	if (bit < 8) {
+		if (state != 2) {
+			shift = (shift << 1) | (sda ? 1 : 0);
+		}
+	} else if (state == 2) {
+		masterAck = !sda;
+	}
+}
+
+/**
+ * Settles line levels after a change, detecting start / stop conditions and SCL edges
+ */
+static void update() {
+	uint8_t i;
+	bool newSda, newScl;
+	for (i = 0; i < 3; i++) {
+		newSda = sdaLevel();
+		newScl = sclLevel();
+		if (newScl && scl && newSda != sda) {
+			if (!newSda) {
+				starts++;
+				state = 0;
+				bit = -1;
+				shift = 0;
+				addressed = true;
+			} else {
+				stops++;
+				addressed = false;
+			}
+			slaveSda = false;
+			sda = newSda;
+			continue;
+		}
+		if (newScl != scl) {
+			scl = newScl;
+			sda = newSda;
+			if (scl) {
+				if (now - lastFall < minLow) {
+					minLow = now - lastFall;
+				}
+				lastRise = now;
+				onRise();
+			} else {
+				if (now - lastRise < minHigh) {
+					minHigh = now - lastRise;
+				}
+				lastFall = now;
+				onFall();
+			}
+			continue;
+		}
+		sda = newSda;
+	}
+}
+
+
+unsigned long millis() {
+	return now / 1000;
+}
+
+unsigned long micros() {
+	now += 1;
+	return now;
+}
+
+void delay(const unsigned long ms) {
+	now += ms * 1000.0;
+}
+
+void delayMicroseconds(const unsigned int us) {
+	now += us;
+}
+
+void yield() { }
+
+int digitalRead(const uint8_t pin) {
+	now += 0.1;
+	update();
+	return pin == URTCLIB_SOFTWIRE_SDA ? sda : scl;
+}
+
+void digitalWrite(const uint8_t, const uint8_t) { }
+
+void pinMode(const uint8_t pin, const uint8_t mode) {
+	now += 0.1;
+	masterLow[pin] = mode == OUTPUT;
+	update();
+}
+
+int digitalPinToInterrupt(const uint8_t pin) {
+	return pin;
+}
+
+void attachInterrupt(const uint8_t, void (*)(), const int) { }
+
+void detachInterrupt(const uint8_t) { }
+
+void noInterrupts() { }
+
+void interrupts() { }
+
+
+/**
+ * Refreshes at given clock and checks decoded data and I2C timing minimums
+ */
+static void refreshAt(uRTCLib &rtc, const uint32_t clock, const double high, const double low) {
+	double start = now;
+	uRTCLibSoftWireBus.setClock(clock);
+	minHigh = 1e9;
+	minLow = 1e9;
+	CHECK(rtc.refresh());
+	printf("clock %lu stretch %d: %.0f us, min tHIGH %.1f tLOW %.1f\n", (unsigned long) clock, stretchMicros, now - start, minHigh, minLow);
+	CHECK(rtc.second() == 30 && rtc.minute() == 45 && rtc.hour() == 12 && rtc.year() == 24);
+	CHECK(rtc.temp() == 2525);
+	CHECK(minHigh >= high);
+	CHECK(minLow >= low);
+}
+
+int main() {
+	uRTCLib rtc(0x68, URTCLIB_MODEL_DS3232);
+	byte written[40], read[40];
+	int i, transactions;
+
+	for (i = 0; i < 256; i++) {
+		regs[i] = i * 7;
+	}
+	regs[0x00] = 0x30;
+	regs[0x01] = 0x45;
+	regs[0x02] = 0x12;
+	regs[0x03] = 0x03;
+	regs[0x04] = 0x15;
+	regs[0x05] = 0x06;
+	regs[0x06] = 0x24;
+	regs[0x0E] = 0x1C;
+	regs[0x0F] = 0x00;
+	regs[0x11] = 0x19;
+	regs[0x12] = 0x40;
+	uRTCLibSoftWireBus.begin();
+
+	// Standard and fast mode, RAM blocks longer than transport buffer
+	refreshAt(rtc, 100000UL, 4.0, 4.7);
+	stretchMicros = 20;
+	refreshAt(rtc, 400000UL, 0.6, 1.3);
+	stretchMicros = 0;
+	for (i = 0; i < 40; i++) {
+		written[i] = i * 13;
+	}
+	starts = 0;
+	CHECK(rtc.ramWriteBlock(10, written, 40));
+	transactions = starts;
+	CHECK(rtc.ramReadBlock(10, read, 40));
+	printf("RAM 40 bytes: %d write and %d read transactions\n", transactions, starts - transactions);
+	CHECK(memcmp(written, read, 40) == 0);
+	CHECK(memcmp(written, regs + 0x14 + 10, 40) == 0);
+
+	// Slow clocks: half periods over 255 us, clock 0 doesn't divide by zero
+	refreshAt(rtc, 1000UL, 500, 500);
+	refreshAt(rtc, 0, 500, 500);
+	uRTCLibSoftWireBus.setClock(100000UL);
+
+	rtc.set(5, 6, 7, 1, 8, 9, 25);
+	CHECK(regs[0x00] == 0x05 && regs[0x01] == 0x06 && regs[0x02] == 0x07 && regs[0x04] == 0x08 && regs[0x06] == 0x25);
+
+	// Errors
+	slaveAddress = 0x50;
+	uRTCLibSoftWireBus.beginTransmission(0x68);
+	uRTCLibSoftWireBus.write(0);
+	CHECK(uRTCLibSoftWireBus.endTransmission() == 2);
+	CHECK(uRTCLibSoftWireBus.requestFrom(0x68, 2) == 0);
+	slaveAddress = 0x68;
+
+	sclStuck = true;
+	uRTCLibSoftWireBus.beginTransmission(0x68);
+	uRTCLibSoftWireBus.write(0);
+	CHECK(uRTCLibSoftWireBus.endTransmission() == 4);
+	sclStuck = false;
+
+	// Overflow: nothing is sent, not even a stop
+	starts = 0;
+	stops = 0;
+	uRTCLibSoftWireBus.beginTransmission(0x68);
+	for (i = 0; i < 40; i++) {
+		uRTCLibSoftWireBus.write(0);
+	}
+	CHECK(uRTCLibSoftWireBus.endTransmission() == 1);
+	CHECK(starts == 0 && stops == 0);
+
+	CHECK(rtc.refresh() && rtc.second() == 5);
+	return simResult();
+}
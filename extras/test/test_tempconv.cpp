@@ -0,0 +1,57 @@
+/**
+ * On-demand temperature conversion host test
+ *
+ * tempConvert() sets CONV unless a conversion is running; tempReady() is true once RTC clears CONV and BSY. A
+ * conversion not ended in #URTCLIB_TEMP_CONV_TIMEOUT ms is given up: tempReady() stays false and tempTimedOut() is
+ * true until next tempConvert().
+ */
+#include <stdio.h>
+#include "sim.h"
+#include "uRTCLib.h"
+
+int main() {
+	uRTCLib rtc(0x68, URTCLIB_MODEL_DS3231);
+	uRTCLib ds1307(0x68, URTCLIB_MODEL_DS1307);
+	int writes;
+
+	simReset(SIM_DS3231);
+	simRegs[0x0E] = 0b00011100;
+	CHECK(rtc.tempReady() && !rtc.tempTimedOut()); // None started
+
+	// Conversion ends in time
+	CHECK(rtc.tempConvert());
+	CHECK(simRegs[0x0E] == 0b00111100);
+	CHECK(!rtc.tempReady());
+	delay(150);
+	simRegs[0x0E] &= 0b11011111; // RTC clears CONV
+	CHECK(rtc.tempReady() && !rtc.tempTimedOut());
+
+	// Automatic conversion running (BSY): no CONV write, ready when BSY clears
+	simRegs[0x0F] = 0b00000100;
+	writes = simRegisterWrites[0x0E];
+	CHECK(rtc.tempConvert());
+	CHECK(simRegisterWrites[0x0E] == writes);
+	CHECK(!rtc.tempReady());
+	simRegs[0x0F] = 0;
+	CHECK(rtc.tempReady());
+
+	// Conversion never ends
+	CHECK(rtc.tempConvert());
+	delay(URTCLIB_TEMP_CONV_TIMEOUT);
+	CHECK(!rtc.tempReady() && !rtc.tempTimedOut());
+	delay(1);
+	CHECK(!rtc.tempReady() && rtc.tempTimedOut());
+	delay(1000);
+	simRegs[0x0E] &= 0b11011111;
+	CHECK(!rtc.tempReady() && rtc.tempTimedOut());
+
+	// Next conversion starts again
+	CHECK(rtc.tempConvert());
+	CHECK(!rtc.tempTimedOut());
+	simRegs[0x0E] &= 0b11011111;
+	CHECK(rtc.tempReady());
+	printf("last conversion %s\n", rtc.tempTimedOut() ? "timed out" : "ended");
+
+	CHECK(!ds1307.tempConvert());
+	return simResult();
+}
@@ -0,0 +1,93 @@
+/**
+ * uRTCLibTimezone host test
+ *
+ * Compares offset and DST flag with glibc localtime_r() for the same TZ strings, from 1971 to 2100 every 3599
+ * seconds and 1 second around each transition: northern and southern hemisphere zones, half hour zones, negative
+ * DST, J and n rules, rule times negative or over 24 hours. EST5EDT without rules uses current US rules on purpose,
+ * so it's compared with glibc given those rules. Local to UTC conversion has to round-trip.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "sim.h"
+#include "uRTCLibTimezone.h"
+
+/**
+ * Checks one instant against glibc, returns true on match
+ */
+static bool same(uRTCLibTimezone &tz, const uint32_t utc) {
+	time_t t = utc;
+	struct tm local;
+	uint32_t back;
+	localtime_r(&t, &local);
+	if (tz.offset(utc) != local.tm_gmtoff || tz.dst(utc) != (local.tm_isdst > 0)) {
+		printf("  %lu: offset %ld dst %d, glibc %ld dst %d\n", (unsigned long) utc, (long) tz.offset(utc), tz.dst(utc), (long) local.tm_gmtoff, local.tm_isdst);
+		return false;
+	}
+	// Repeated local times are taken as DST
+	back = tz.toUtc(tz.toLocal(utc));
+	if (back != utc && !(tz.dst(back) && tz.toLocal(back) == tz.toLocal(utc))) {
+		printf("  %lu: local %lu back to %lu\n", (unsigned long) utc, (unsigned long) tz.toLocal(utc), (unsigned long) back);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Compares a zone with glibc over whole range
+ */
+static void zone(const char *tz, const char *glibc) {
+	uRTCLib rtc(0x68, URTCLIB_MODEL_DS3231);
+	uRTCLibTimezone timezone(rtc);
+	uint32_t utc, edge[2];
+	int i, errors = 0, transitions = 0;
+
+	setenv("TZ", glibc, 1);
+	tzset();
+	CHECK(timezone.begin(tz));
+	for (utc = 31536000UL; utc < 4102444800UL && errors < 5; utc += 3599) {
+		errors += !same(timezone, utc);
+	}
+	for (utc = 31536000UL + 86400UL * 180; utc < 4102444800UL && errors < 5; utc += 86400UL * 365) {
+		timezone.dst(utc);
+		edge[0] = timezone.dstStart();
+		edge[1] = timezone.dstEnd();
+		for (i = 0; i < 2; i++) {
+			if (edge[i] == 0) {
+				continue;
+			}
+			errors += !same(timezone, edge[i] - 1);
+			errors += !same(timezone, edge[i]);
+			transitions++;
+		}
+	}
+	printf("%s: %d transitions, %d errors\n", tz, transitions, errors);
+	CHECK(errors == 0);
+}
+
+int main() {
+	uRTCLib rtc(0x68, URTCLIB_MODEL_DS3231);
+	uRTCLibTimezone timezone(rtc);
+
+	simReset(SIM_DS3231);
+	zone("CET-1CEST,M3.5.0,M10.5.0/3", "CET-1CEST,M3.5.0,M10.5.0/3");
+	zone("EST5EDT,M3.2.0,M11.1.0", "EST5EDT,M3.2.0,M11.1.0");
+	zone("EST5EDT", "EST5EDT,M3.2.0,M11.1.0");
+	zone("AEST-10AEDT,M10.1.0,M4.1.0/3", "AEST-10AEDT,M10.1.0,M4.1.0/3");
+	zone("NZST-12NZDT,M9.5.0,M4.1.0/3", "NZST-12NZDT,M9.5.0,M4.1.0/3");
+	zone("<+1030>-10:30<+11>-11,M10.1.0,M4.1.0", "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0");
+	zone("<-04>4<-03>,M9.1.6/24,M4.1.6/24", "<-04>4<-03>,M9.1.6/24,M4.1.6/24");
+	zone("<-02>2<-01>,M3.5.0/-1,M10.5.0/0", "<-02>2<-01>,M3.5.0/-1,M10.5.0/0");
+	zone("IST-1GMT0,M10.5.0,M3.5.0/1", "IST-1GMT0,M10.5.0,M3.5.0/1");
+	zone("<+0330>-3:30<+0430>,J79/24,J263/24", "<+0330>-3:30<+0430>,J79/24,J263/24");
+	zone("XST3XDT,80/2,300/2", "XST3XDT,80/2,300/2");
+	zone("<-03>3<-02>,M3.2.0/-26,M11.1.0/50", "<-03>3<-02>,M3.2.0/-26,M11.1.0/50");
+	zone("<-03>3", "<-03>3");
+
+	// Wrong strings leave UTC
+	CHECK(!timezone.begin("CET"));
+	CHECK(!timezone.begin("CET-1CEST,M3.5.0"));
+	CHECK(!timezone.begin("CET-1CEST,M13.5.0,M10.5.0"));
+	CHECK(timezone.offset(1700000000UL) == 0 && !timezone.dst(1700000000UL));
+	return simResult();
+}
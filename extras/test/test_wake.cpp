@@ -0,0 +1,161 @@
+/**
+ * Wake timer and watchdog host test
+ *
+ * Alarm 1 registers programmed by wakeEvery() / wakeRearm() across month, leap February and year ends, for periods
+ * under and over 1 day, missed wakes and periods split in #URTCLIB_WAKE_MAX_STEP steps. Watchdog on Alarm 2: begin,
+ * kick rate limit and minute wrap, expiry seen on next boot, stop. Status flags set by the device between reads and
+ * writes are never cleared.
+ */
+#include <stdio.h>
+#include <time.h>
+#include "sim.h"
+#include "uRTCLib.h"
+
+/**
+ * Sets RTC time registers, 24 hour mode
+ */
+static void setTime(const uint32_t utc) {
+	time_t t = utc;
+	struct tm g;
+	gmtime_r(&t, &g);
+	simRegs[0x00] = (g.tm_sec / 10) * 16 + g.tm_sec % 10;
+	simRegs[0x01] = (g.tm_min / 10) * 16 + g.tm_min % 10;
+	simRegs[0x02] = (g.tm_hour / 10) * 16 + g.tm_hour % 10;
+	simRegs[0x03] = g.tm_wday + 1;
+	simRegs[0x04] = (g.tm_mday / 10) * 16 + g.tm_mday % 10;
+	simRegs[0x05] = ((g.tm_mon + 1) / 10) * 16 + (g.tm_mon + 1) % 10;
+	simRegs[0x06] = ((g.tm_year - 100) / 10) * 16 + (g.tm_year - 100) % 10;
+}
+
+/**
+ * Checks Alarm 1 registers: seconds, minutes, hours and day / A1M4 byte; INTCN and A1IE set, A1F cleared
+ */
+static bool alarm1(const uint8_t second, const uint8_t minute, const uint8_t hour, const uint8_t day) {
+	printf("  alarm 1: %02x %02x %02x %02x, control %02x status %02x\n", simRegs[0x07], simRegs[0x08], simRegs[0x09], simRegs[0x0A], simRegs[0x0E], simRegs[0x0F]);
+	return simRegs[0x07] == second && simRegs[0x08] == minute && simRegs[0x09] == hour && simRegs[0x0A] == day
+		&& (simRegs[0x0E] & 0b00000101) == 0b00000101 && !(simRegs[0x0F] & 0b00000001);
+}
+
+/**
+ * Wake: RTC time reaches given instant with A1F set, then wakeRearm()
+ */
+static bool wake(uRTCLib &rtc, const uint32_t utc) {
+	setTime(utc);
+	simRegs[0x0F] |= 0b00000001;
+	rtc.refresh();
+	return rtc.wakeRearm();
+}
+
+int main() {
+	uRTCLib rtc(0x68, URTCLIB_MODEL_DS3231);
+	uRTCLib ds1307(0x68, URTCLIB_MODEL_DS1307);
+	uint32_t next;
+	int transactions;
+
+	simReset(SIM_DS3231);
+
+	// Month end, under 1 day: HMS type, A1M4 set
+	setTime(1706745570UL); // 2024-01-31 23:59:30
+	rtc.refresh();
+	CHECK(rtc.wakeEvery(60));
+	CHECK(rtc.wakeNext() == 1706745630UL);
+	CHECK(alarm1(0x30, 0x00, 0x00, 0x81));
+	CHECK(rtc.alarmMode(URTCLIB_ALARM_1) == URTCLIB_ALARM_TYPE_1_FIXED_HMS);
+
+	// No A1F, nothing written
+	memset(simRegisterWrites, 0, sizeof(simRegisterWrites));
+	CHECK(!rtc.wakeRearm());
+	CHECK(simRegisterWrites[0x07] == 0);
+
+	// Woken on time; OSF and A2F set meanwhile are kept
+	simStatusRace = 0b10000010;
+	CHECK(wake(rtc, 1706745630UL));
+	CHECK(rtc.wakeNext() == 1706745690UL);
+	CHECK(alarm1(0x30, 0x01, 0x00, 0x81));
+	CHECK((simRegs[0x0F] & 0b10000010) == 0b10000010);
+	simRegs[0x0F] = 0;
+
+	// Missed wakes are skipped, schedule is kept
+	CHECK(wake(rtc, 1706745690UL + 210));
+	CHECK(rtc.wakeNext() == 1706745690UL + 240);
+	CHECK(alarm1(0x30, 0x05, 0x00, 0x81));
+
+	// Leap February end, over 1 day: DHMS type, day of month
+	setTime(1709161200UL); // 2024-02-28 23:00:00
+	rtc.refresh();
+	CHECK(rtc.wakeEvery(90000UL));
+	CHECK(alarm1(0x00, 0x00, 0x00, 0x01)); // 2024-03-01 00:00:00
+	CHECK(rtc.alarmMode(URTCLIB_ALARM_1) == URTCLIB_ALARM_TYPE_1_FIXED_DHMS);
+	CHECK(wake(rtc, 1709251200UL));
+	CHECK(alarm1(0x00, 0x00, 0x01, 0x02)); // 2024-03-02 01:00:00
+
+	// Year end
+	setTime(1735646400UL); // 2024-12-31 12:00:00
+	rtc.refresh();
+	CHECK(rtc.wakeEvery(172800UL));
+	CHECK(alarm1(0x00, 0x00, 0x12, 0x02)); // 2025-01-02 12:00:00
+	CHECK(wake(rtc, 1735819200UL));
+	CHECK(alarm1(0x00, 0x00, 0x12, 0x04));
+
+	// 40 days: one step of URTCLIB_WAKE_MAX_STEP, then the rest
+	setTime(1735646400UL); // 2024-12-31 12:00:00
+	rtc.refresh();
+	CHECK(rtc.wakeEvery(3456000UL));
+	next = rtc.wakeNext();
+	CHECK(next == 1735646400UL + 3456000UL);
+	CHECK(alarm1(0x00, 0x00, 0x12, 0x28)); // 2025-01-28 12:00:00
+	CHECK(!wake(rtc, 1735646400UL + URTCLIB_WAKE_MAX_STEP));
+	CHECK(rtc.wakeNext() == next);
+	CHECK(alarm1(0x00, 0x00, 0x12, 0x09)); // 2025-02-09 12:00:00
+	CHECK(wake(rtc, next));
+	CHECK(rtc.wakeNext() == next + 3456000UL);
+
+	CHECK(rtc.wakeStop());
+	CHECK(rtc.wakeNext() == 0 && !(simRegs[0x0E] & 0b00000001));
+
+	// Watchdog
+	CHECK(!rtc.watchdogBegin(1) && !rtc.watchdogBegin(60));
+	simRegs[0x01] = 0x58;
+	simRegs[0x0F] = 0;
+	simStatusRace = 0b10000001; // OSF and A1F set meanwhile are kept
+	CHECK(rtc.watchdogBegin(5));
+	CHECK(simRegs[0x0B] == 0x03 && simRegs[0x0C] == 0x80 && simRegs[0x0D] == 0x80);
+	CHECK((simRegs[0x0E] & 0b00000110) == 0b00000110);
+	CHECK(simRegs[0x0F] == 0b10000001);
+	CHECK(!rtc.watchdogFired());
+
+	// Kicks access RTC only once per interval
+	simRegs[0x01] = 0x10;
+	transactions = simTransactions;
+	rtc.watchdogKick();
+	CHECK(simTransactions == transactions && simRegs[0x0B] == 0x03);
+	delay(URTCLIB_WATCHDOG_KICK_INTERVAL);
+	rtc.watchdogKick();
+	CHECK(simRegs[0x0B] == 0x15);
+	transactions = simTransactions;
+	simRegs[0x01] = 0x57;
+	rtc.watchdogKick();
+	CHECK(simTransactions == transactions && simRegs[0x0B] == 0x15);
+	delay(URTCLIB_WATCHDOG_KICK_INTERVAL);
+	rtc.watchdogKick();
+	CHECK(simRegs[0x0B] == 0x02);
+
+	// Not kicked: Alarm 2 fires, INT resets MCU, next boot sees it
+	simRegs[0x0F] |= 0b00000010;
+	{
+		uRTCLib boot(0x68, URTCLIB_MODEL_DS3231);
+		CHECK(boot.watchdogBegin(5));
+		CHECK(boot.watchdogFired());
+		CHECK(!(simRegs[0x0F] & 0b00000010));
+		CHECK(boot.watchdogStop());
+		CHECK(!(simRegs[0x0E] & 0b00000010));
+		transactions = simTransactions;
+		delay(URTCLIB_WATCHDOG_KICK_INTERVAL);
+		boot.watchdogKick();
+		CHECK(simTransactions == transactions);
+	}
+
+	// DS1307 has no alarms
+	CHECK(!ds1307.wakeEvery(60) && !ds1307.watchdogBegin(5));
+	return simResult();
+}
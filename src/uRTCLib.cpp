@@ -34,21 +34,63 @@
  */
 
 #include <Arduino.h>
-#ifndef URTCLIB_WIRE
-	#if defined(ARDUINO_attiny) || defined(ARDUINO_AVR_ATTINYX4) || defined(ARDUINO_AVR_ATTINYX5) || defined(ARDUINO_AVR_ATTINYX7) || defined(ARDUINO_AVR_ATTINYX8) || defined(ARDUINO_AVR_ATTINYX61) || defined(ARDUINO_AVR_ATTINY43) || defined(ARDUINO_AVR_ATTINY828) || defined(ARDUINO_AVR_ATTINY1634) || defined(ARDUINO_AVR_ATTINYX313)
-		#include <TinyWireM.h>                  // I2C Master lib for ATTinys which use USI
-		#define URTCLIB_WIRE TinyWireM
-	#else
-		#include <Wire.h>
-		#define URTCLIB_WIRE Wire
-	#endif
-#endif
 #include "uRTCLib.h"
 
+#if defined(URTCLIB_SOFTWIRE_SDA) && defined(URTCLIB_SOFTWIRE_SCL)
+/**
+ * \brief Software I2C bus used as URTCLIB_WIRE, see uRTCLibSoftWire
+ */
+uRTCLibSoftWire<URTCLIB_SOFTWIRE_SDA, URTCLIB_SOFTWIRE_SCL> uRTCLibSoftWireBus;
+#endif
+
+#ifndef pgm_read_byte
+	#define pgm_read_byte(address) (*(const uint8_t *) (address))
+#endif
+
+/**
+ * \brief 2 digits table, "00" to "99", used by format()
+ */
+static const char uRTCLib_digitPairs[] PROGMEM = "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+/**
+ * \brief Writes 2 decimal digits
+ *
+ * @param p Destination
+ * @param value 0 to 99, bigger ones are written as 99
+ *
+ * @return Position after written digits
+ */
+static char * uRTCLib_putPair(char *p, uint8_t value) {
+	if (value > 99) {
+		value = 99;
+	}
+	p[0] = pgm_read_byte(&uRTCLib_digitPairs[value * 2]);
+	p[1] = pgm_read_byte(&uRTCLib_digitPairs[value * 2 + 1]);
+	return p + 2;
+}
+
+/**
+ * \brief Reads 2 decimal digits
+ *
+ * @param p Source
+ *
+ * @return Value, -1 if any of them is not a digit
+ */
+static int8_t uRTCLib_getPair(const char *p) {
+	if (p[0] < '0' || p[0] > '9' || p[1] < '0' || p[1] > '9') {
+		return -1;
+	}
+	return (p[0] - '0') * 10 + (p[1] - '0');
+}
+
 /**
  * \brief Constructor
  */
-uRTCLib::uRTCLib() { }
+uRTCLib::uRTCLib() {
+	#ifdef URTCLIB_PACKED
+	_packedInit();
+	#endif
+}
 
 /**
  * \brief Constructor
@@ -56,6 +98,9 @@ uRTCLib::uRTCLib() { }
  * @param rtc_address I2C address of RTC
  */
 uRTCLib::uRTCLib(const int rtc_address) {
+	#ifdef URTCLIB_PACKED
+	_packedInit();
+	#endif
 	_rtc_address = rtc_address;
 }
 
@@ -69,24 +114,74 @@ uRTCLib::uRTCLib(const int rtc_address) {
  *	 - #URTCLIB_MODEL_DS3232
  */
 uRTCLib::uRTCLib(const int rtc_address, const uint8_t model) {
+	#ifdef URTCLIB_PACKED
+	_packedInit();
+	#endif
 	_rtc_address = rtc_address;
 	_model = model;
 }
 
+#ifdef URTCLIB_PACKED
+/**
+ * \brief Sets packed fields to the defaults of regular layout
+ */
+void uRTCLib::_packedInit() {
+	_second = 0;
+	_minute = 0;
+	_hour = 0;
+	_month = 0;
+	_model = URTCLIB_MODEL_DS3232;
+	#ifndef URTCLIB_NO_DETECT
+	_detected_model = URTCLIB_MODEL_UNKNOWN;
+	#endif
+	#ifndef URTCLIB_NO_MONOTONIC
+	_monotonic = false;
+	#endif
+	_dayOfWeek = 0;
+	_day = 0;
+	_year = 0;
+	#ifndef URTCLIB_NO_POWER_PROFILE
+	_power_profile = URTCLIB_POWER_CRATE_64S;
+	#endif
+	#ifndef URTCLIB_NO_TEMP_CONV
+	_tempConvState = 0;
+	#endif
+	#ifndef URTCLIB_NO_ALARMS
+	_a1_mode = URTCLIB_ALARM_TYPE_1_NONE;
+	_a1_second = 0;
+	_a1_minute = 0;
+	_a1_hour = 0;
+	_a1_day_dow = 0;
+	_a2_mode = URTCLIB_ALARM_TYPE_2_NONE;
+	_a2_minute = 0;
+	_a2_hour = 0;
+	_a2_day_dow = 0;
+	#endif
+	#ifndef URTCLIB_NO_WAKE
+	_watchdogFired = false;
+	_watchdogTimeout = 0;
+	#endif
+	#ifndef URTCLIB_NO_SQWG
+	_sqwg_mode = URTCLIB_SQWG_OFF_1;
+	#endif
+}
+#endif
+
 /**
  * \brief Refresh data from HW RTC
  *
  * @return False on error
  */
 bool uRTCLib::refresh() {
-	uRTCLIB_YIELD
-	URTCLIB_WIRE.beginTransmission(_rtc_address);
-	URTCLIB_WIRE.write(0); // set DS3231 register pointer to 00h
-	URTCLIB_WIRE.endTransmission();
-	uRTCLIB_YIELD
-
+	#ifndef URTCLIB_NO_CHANGES
+	// Previous values, for change mask
+	uint8_t prevSecond = _second, prevMinute = _minute, prevHour = _hour, prevDay = _day, prevMonth = _month, prevYear = _year, prevStatus = _controlStatus, i;
+	#ifndef URTCLIB_NO_TEMP
+	int16_t prevTemp = _temp;
+	#endif
+	#endif
 	// Adjust requested bytes to selected model:
-	uRTCLIB_SIZE_T bytesRequested = 0;
+	uint8_t reg[19], bytesRequested;
 	switch (_model) {
 		case URTCLIB_MODEL_DS1307:
 			bytesRequested = 8;
@@ -96,35 +191,23 @@ bool uRTCLib::refresh() {
 		// case URTCLIB_MODEL_DS3231: // Commented out because it's default mode
 		// case URTCLIB_MODEL_DS3232: // Commented out because it's default mode
 		default:
-	        #if defined(ARDUINO_attiny) || defined(ARDUINO_AVR_ATTINYX4) || defined(ARDUINO_AVR_ATTINYX5) || defined(ARDUINO_AVR_ATTINYX7) || defined(ARDUINO_AVR_ATTINYX8) || defined(ARDUINO_AVR_ATTINYX61) || defined(ARDUINO_AVR_ATTINY43) || defined(ARDUINO_AVR_ATTINY828) || defined(ARDUINO_AVR_ATTINY1634) || defined(ARDUINO_AVR_ATTINYX313)
-		        bytesRequested = 8;
-	        #else
-		        bytesRequested = 19;
-	        #endif
-	        break;
-    }
-
-	uint8_t bytesReceived = URTCLIB_WIRE.requestFrom(_rtc_address, bytesRequested);
-	#if defined(ARDUINO_attiny) || defined(ARDUINO_AVR_ATTINYX4) || defined(ARDUINO_AVR_ATTINYX5) || defined(ARDUINO_AVR_ATTINYX7) || defined(ARDUINO_AVR_ATTINYX8) || defined(ARDUINO_AVR_ATTINYX61) || defined(ARDUINO_AVR_ATTINY43) || defined(ARDUINO_AVR_ATTINY828) || defined(ARDUINO_AVR_ATTINY1634) || defined(ARDUINO_AVR_ATTINYX313)
-	    if (bytesReceived != 0) {
-		    // Error
-		    return false;
-	    }
-	#else
-	    if (bytesReceived < bytesRequested) {
-		    // Error
-		    return false;
-	    }
-	#endif
+			bytesRequested = 19;
+			break;
+	}
+
+	// Split by transfer engine when transport buffer is smaller
+	if (!_readRegisters(0, reg, bytesRequested)) {
+		// Error
+		return false;
+	}
 	// 0x00h
-	uint8_t tempByte = URTCLIB_WIRE.read();
+	uint8_t tempByte = reg[0x00];
 	// On DS1307 EOSC and lost_power functions are combined in CH (Clock Halt).
 	// It is placed on 1st bit of 1st byte.
 	// So use that flag to mark both
 	if (_model == URTCLIB_MODEL_DS1307) {
     	_controlStatus |= (((tempByte >> 1) & 0b01000000) | (tempByte & 0b10000000));
 	}
-	uRTCLIB_YIELD
 	// Parentheses reqired on bitwise operation for correct uRTCLIB_bcdToDec operation
 	// Serial.print("byte_00h "); Serial.println(tempByte, BIN);
 	// Serial.print("byte_00h_bcdToDec_with_parentheses "); Serial.println(uRTCLIB_bcdToDec((tempByte & 0b01111111)));
@@ -133,50 +216,50 @@ bool uRTCLib::refresh() {
 	// Serial.print("_second "); Serial.println(_second);
 
 	// 0x01h
-	_minute = URTCLIB_WIRE.read() & 0b01111111;
-	uRTCLIB_YIELD
+	_minute = reg[0x01] & 0b01111111;
 	_minute = uRTCLIB_bcdToDec(_minute);
 
 	// 0x02h
-	_hour = URTCLIB_WIRE.read() & 0b01111111;
-	uRTCLIB_YIELD
-	// Serial.print("0x02h "); Serial.println(_hour, BIN);
-	bool _12hrMode = (bool) (_hour & 0b01000000);
-	bool _pmNotAm = (bool) (_hour & 0b00100000);
+	tempByte = reg[0x02] & 0b01111111;
+	// Serial.print("0x02h "); Serial.println(tempByte, BIN);
+	#ifdef URTCLIB_NO_12H
+	_hour = uRTCLIB_bcdToDec((tempByte & 0b00111111));
+	#else
+	bool _12hrMode = (bool) (tempByte & 0b01000000);
+	bool _pmNotAm = (bool) (tempByte & 0b00100000);
 	if(_12hrMode)
-		_hour = _hour & 0b00011111;
+		_hour = uRTCLIB_bcdToDec((tempByte & 0b00011111));
 	else
-		_hour = _hour & 0b00111111;
-	_hour = uRTCLIB_bcdToDec(_hour);
+		_hour = uRTCLIB_bcdToDec((tempByte & 0b00111111));
+	#endif
 
 	// 0x03h
-	_dayOfWeek = URTCLIB_WIRE.read();
-	uRTCLIB_YIELD
+	_dayOfWeek = reg[0x03];
 	_dayOfWeek = uRTCLIB_bcdToDec(_dayOfWeek);
 
 	// 0x04h
-	_day = URTCLIB_WIRE.read();
-	uRTCLIB_YIELD
+	_day = reg[0x04];
 	_day = uRTCLIB_bcdToDec(_day);
 
 	// 0x05h
-	_month = URTCLIB_WIRE.read() & 0b00011111;
-	uRTCLIB_YIELD
+	_month = reg[0x05] & 0b00011111;
 	_month = uRTCLIB_bcdToDec(_month);
 
 	// 0x06h
-	_year = URTCLIB_WIRE.read();
-	uRTCLIB_YIELD
+	_year = reg[0x06];
 	_year = uRTCLIB_bcdToDec(_year);
 
+	#ifndef URTCLIB_NO_TEMP
 	_temp = URTCLIB_TEMP_ERROR; // Some obvious error value
+	#endif
 
 	// Now we need to read extra requested bytes depending on the RTC model again:
 	switch (_model) {
 		case URTCLIB_MODEL_DS1307:
+			#ifndef URTCLIB_NO_SQWG
 			uint8_t status;
 			// 0x07h
-			status = URTCLIB_WIRE.read();
+			status = reg[0x07];
 			if (status & 0b00010000) {
 				_sqwg_mode = status & 0b10000000 ? URTCLIB_SQWG_OFF_1 : URTCLIB_SQWG_OFF_0;
 			} else {
@@ -201,117 +284,110 @@ bool uRTCLib::refresh() {
 						break;
 				}
 			}
+			#endif
+			#ifndef URTCLIB_NO_12H
 			if(_12hrMode) _controlStatus |= 0b00100000;
 			if(_pmNotAm) _controlStatus |= 0b00010000;
+			#endif
 			// Serial.print("_controlStatus "); Serial.println(_controlStatus, BIN);
 			break;
 
 		// case URTCLIB_MODEL_DS3231: // Commented out because it's default mode
 		// case URTCLIB_MODEL_DS3232: // Commented out because it's default mode
 		default:
-            #if defined(ARDUINO_attiny) || defined(ARDUINO_AVR_ATTINYX4) || defined(ARDUINO_AVR_ATTINYX5) || defined(ARDUINO_AVR_ATTINYX7) || defined(ARDUINO_AVR_ATTINYX8) || defined(ARDUINO_AVR_ATTINYX61) || defined(ARDUINO_AVR_ATTINY43) || defined(ARDUINO_AVR_ATTINY828) || defined(ARDUINO_AVR_ATTINY1634) || defined(ARDUINO_AVR_ATTINYX313)
-            	bytesRequested = 11;
-                bytesReceived = URTCLIB_WIRE.requestFrom(_rtc_address, bytesRequested);
-                if (bytesReceived != 0) {
-                    // Error
-                    return false;
-                }
-            #endif
-			uint8_t MSB, LSB; // LSB is also used as tmp  variable
+			uint8_t LSB; // Also used as tmp  variable
 
+			#ifndef URTCLIB_NO_ALARMS
 			_a1_mode = URTCLIB_ALARM_TYPE_1_NONE;
 			_a2_mode = URTCLIB_ALARM_TYPE_2_NONE;
 
+			// Raw bytes are kept on LSB, so fields only get decoded values (see #URTCLIB_PACKED)
 			// 0x07h
-			_a1_second = URTCLIB_WIRE.read();
-			uRTCLIB_YIELD
-			_a1_mode = _a1_mode | ((_a1_second & 0b10000000) >> 7);
-			_a1_second = uRTCLIB_bcdToDec((_a1_second & 0b01111111));   //parentheses for bitwise operation as argument for uRTCLIB_bcdToDec is required
+			LSB = reg[0x07];
+			_a1_mode = _a1_mode | ((LSB & 0b10000000) >> 7);
+			_a1_second = uRTCLIB_bcdToDec((LSB & 0b01111111));   //parentheses for bitwise operation as argument for uRTCLIB_bcdToDec is required
 																		//otherwise wrong result will be returned by function
 
 			// 0x08h
-			_a1_minute = URTCLIB_WIRE.read();
-			uRTCLIB_YIELD
-			_a1_mode = _a1_mode | ((_a1_minute & 0b10000000) >> 6);
-			_a1_minute = uRTCLIB_bcdToDec((_a1_minute & 0b01111111));
+			LSB = reg[0x08];
+			_a1_mode = _a1_mode | ((LSB & 0b10000000) >> 6);
+			_a1_minute = uRTCLIB_bcdToDec((LSB & 0b01111111));
 
 			// 0x09h
-			_a1_hour = URTCLIB_WIRE.read();
-			uRTCLIB_YIELD
-			_a1_mode = _a1_mode | ((_a1_hour & 0b10000000) >> 5);
-			_a1_hour = uRTCLIB_bcdToDec((_a1_hour & 0b00111111));
+			LSB = reg[0x09];
+			_a1_mode = _a1_mode | ((LSB & 0b10000000) >> 5);
+			_a1_hour = uRTCLIB_bcdToDec((LSB & 0b00111111));
 
 			// 0x0Ah
-			_a1_day_dow = URTCLIB_WIRE.read();
-			uRTCLIB_YIELD
-			_a1_mode = _a1_mode | ((_a1_day_dow & 0b10000000) >> 4);
+			LSB = reg[0x0A];
+			_a1_mode = _a1_mode | ((LSB & 0b10000000) >> 4);
 			if (!(_a1_mode & 0b00001111)) {
-				_a1_mode = _a1_mode | ((_a1_day_dow & 0b01000000) >> 2);
+				_a1_mode = _a1_mode | ((LSB & 0b01000000) >> 2);
 			}
-			_a1_day_dow = _a1_day_dow & 0b00111111;
-			_a1_day_dow = uRTCLIB_bcdToDec(_a1_day_dow);
+			_a1_day_dow = uRTCLIB_bcdToDec((LSB & 0b00111111));
 
 			// 0x0Bh
-			_a2_minute = URTCLIB_WIRE.read();
-			uRTCLIB_YIELD
-			_a2_mode = _a2_mode | ((_a2_minute & 0b10000000) >> 6);
-			_a2_minute = _a2_minute & 0b01111111;
-			_a2_minute = uRTCLIB_bcdToDec(_a2_minute);
+			LSB = reg[0x0B];
+			_a2_mode = _a2_mode | ((LSB & 0b10000000) >> 6);
+			_a2_minute = uRTCLIB_bcdToDec((LSB & 0b01111111));
 
 			// 0x0Ch
-			_a2_hour = URTCLIB_WIRE.read();
-			uRTCLIB_YIELD
-			_a2_mode = _a2_mode | ((_a2_hour & 0b10000000) >> 5);
-			_a2_hour = _a2_hour & 0b00111111;
-			_a2_hour = uRTCLIB_bcdToDec(_a2_hour);
+			LSB = reg[0x0C];
+			_a2_mode = _a2_mode | ((LSB & 0b10000000) >> 5);
+			_a2_hour = uRTCLIB_bcdToDec((LSB & 0b00111111));
 
 			// 0x0Dh
-			_a2_day_dow = URTCLIB_WIRE.read();
-			uRTCLIB_YIELD
-			_a2_mode = _a2_mode | ((_a2_day_dow & 0b10000000) >> 4);
+			LSB = reg[0x0D];
+			_a2_mode = _a2_mode | ((LSB & 0b10000000) >> 4);
 			if (!(_a2_mode & 0b00001110)) { // M4-M2 is 0, check DT/DY
-				_a2_mode = _a2_mode | ((_a2_day_dow & 0b01000000) >> 2);
+				_a2_mode = _a2_mode | ((LSB & 0b01000000) >> 2);
 			}
-			_a2_day_dow = uRTCLIB_bcdToDec(_a2_day_dow & 0b00111111);
+			_a2_day_dow = uRTCLIB_bcdToDec((LSB & 0b00111111));
+			#endif
 
 
 			// Control registers
 			// 0x0Eh
-			LSB = URTCLIB_WIRE.read();
-			uRTCLIB_YIELD
+			LSB = reg[0x0E];
 			// Serial.print("0x0Eh "); Serial.println(LSB, BIN);
 
 			bool _eosc = (bool) (LSB & 0b10000000);
 			// Serial.print("_eosc "); Serial.println(_eosc);
-			if (LSB & 0b00000100) {
-				_sqwg_mode = URTCLIB_SQWG_OFF_1;
-				// Alarms disabled?
-				if (LSB & 0b00000001) {
-					_a1_mode |= 0b00100000;
-				} else {
-					_a1_mode = URTCLIB_ALARM_TYPE_1_NONE;
-				}
-				if (LSB & 0b00000010) {
-					_a2_mode |= 0b00100000;
-				} else {
-					_a2_mode = URTCLIB_ALARM_TYPE_2_NONE;
-				}
+			#ifndef URTCLIB_NO_POWER_PROFILE
+			_power_profile = (LSB & 0b01000000) >> 3; // BBSQW
+			#endif
+			#ifndef URTCLIB_NO_SQWG
+			_sqwg_mode = (LSB & 0b00000100) ? URTCLIB_SQWG_OFF_1 : LSB & 0b00011000;
+			#endif
+			#ifndef URTCLIB_NO_ALARMS
+			// Alarms disabled? With SQWG (INTCN = 0) they are disabled too
+			if ((LSB & 0b00000101) == 0b00000101) {
+				_a1_mode |= 0b00100000;
 			} else {
-				_sqwg_mode = LSB & 0b00011000;
-				// Mark alarms as disabled because the SQWG:
 				_a1_mode = URTCLIB_ALARM_TYPE_1_NONE;
+			}
+			if ((LSB & 0b00000110) == 0b00000110) {
+				_a2_mode |= 0b00100000;
+			} else {
 				_a2_mode = URTCLIB_ALARM_TYPE_2_NONE;
 			}
+			#endif
 
 
 			// 0x0Fh
-			LSB = URTCLIB_WIRE.read(); //Control
-			uRTCLIB_YIELD
+			LSB = reg[0x0F]; //Control
 			// Serial.print("0x0Fh "); Serial.println(LSB, BIN);
-			_controlStatus = LSB;
+			#ifndef URTCLIB_NO_POWER_PROFILE
+			if (_model == URTCLIB_MODEL_DS3232) {
+				_power_profile |= (LSB & 0b01110000) >> 4; // BB32kHz, CRATE1, CRATE0
+			}
+			#endif
+			_controlStatus = LSB & 0b10001011; // Bits 6-4 are used for other flags, bit 2 is BSY
 			if(_eosc) _controlStatus |= 0b01000000;
+			#ifndef URTCLIB_NO_12H
 			if(_12hrMode) _controlStatus |= 0b00100000;
 			if(_pmNotAm) _controlStatus |= 0b00010000;
+			#endif
 			// Serial.print("_controlStatus "); Serial.println(_controlStatus, BIN);
 			// _lost_power = (bool) (_controlStatus & 0b10000000);
 			// _eosc = (bool) (_controlStatus & 0b01000000);
@@ -323,32 +399,132 @@ bool uRTCLib::refresh() {
 
 
 			// 0x10h
-			_aging = URTCLIB_WIRE.read(); //Aging
-			uRTCLIB_YIELD
+			#ifndef URTCLIB_NO_AGING
+			_aging = reg[0x10]; //Aging
 			if (_aging & 0b10000000) {
 				_aging--;
 			}
+			#endif
 
 
 			// Temperature registers (11h-12h) get updated automatically every 64s
-
+			#ifndef URTCLIB_NO_TEMP
 			// 0x11h
-			MSB = URTCLIB_WIRE.read(); //2's complement int portion
-			uRTCLIB_YIELD
+			uint8_t MSB;
+			MSB = reg[0x11]; //2's complement int portion
 			// 0x12h
-			LSB = URTCLIB_WIRE.read(); //fraction portion
-			uRTCLIB_YIELD
-			_temp = 0b0000000000000000 | (MSB  << 2) | (LSB >> 6); // 8+2 bits, *25 is the same as number + 2bitdecimals * 100 in base 10
-			if (MSB & 0b10000000) {
-				_temp = (_temp | 0b1111110000000000);
-				_temp--;
-			}
-			_temp = _temp * 25; // *25 is the same as number + 2bit (decimals) * 100 in base 10
+			LSB = reg[0x12]; //fraction portion
+			_temp = _tempDecode(MSB, LSB);
+			#ifndef URTCLIB_NO_AGING_PROFILE
+			_agingProfileApply();
+			#endif
+			#endif
 			break;
 	}
+
+	#ifndef URTCLIB_NO_CHANGES
+	_changes = 0;
+	if (_second != prevSecond) _changes |= URTCLIB_CHANGE_SECOND;
+	if (_minute != prevMinute) _changes |= URTCLIB_CHANGE_MINUTE;
+	if (_hour != prevHour) _changes |= URTCLIB_CHANGE_HOUR;
+	if (_day != prevDay) _changes |= URTCLIB_CHANGE_DAY;
+	if (_month != prevMonth || _year != prevYear) _changes |= URTCLIB_CHANGE_MONTH;
+	if (_controlStatus & ~prevStatus & 0b00000011) _changes |= URTCLIB_CHANGE_ALARM; // A2F, A1F set
+	if (_controlStatus & ~prevStatus & 0b10000000) _changes |= URTCLIB_CHANGE_LOST_POWER;
+	#ifndef URTCLIB_NO_TEMP
+	if (_temp != prevTemp) _changes |= URTCLIB_CHANGE_TEMP;
+	#endif
+	if (_changes) {
+		for (i = 0; i < URTCLIB_CHANGE_CALLBACKS; i++) {
+			if (_change_callbacks[i] != NULL && (_change_masks[i] & _changes)) {
+				_change_callbacks[i](_changes);
+			}
+		}
+	}
+	#endif
 	return true;
 }
 
+#ifndef URTCLIB_NO_CHANGES
+/**
+ * \brief Returns what changed on last refresh()
+ *
+ * Computed while decoding from cached values, no extra I2C access. On first refresh fields are compared against 0.
+ *
+ * @return Change mask, an OR of:
+ *	 - #URTCLIB_CHANGE_SECOND
+ *	 - #URTCLIB_CHANGE_MINUTE
+ *	 - #URTCLIB_CHANGE_HOUR
+ *	 - #URTCLIB_CHANGE_DAY
+ *	 - #URTCLIB_CHANGE_MONTH
+ *	 - #URTCLIB_CHANGE_ALARM
+ *	 - #URTCLIB_CHANGE_LOST_POWER
+ *	 - #URTCLIB_CHANGE_TEMP
+ */
+uint8_t uRTCLib::changes() {
+	return _changes;
+}
+
+/**
+ * \brief Registers a function to be called from refresh() when selected fields change
+ *
+ * Callback receives the whole change mask of that refresh.
+ *
+ * @param mask Changes that trigger the callback, see changes()
+ * @param callback Function to call, NULL to remove all registrations with given mask
+ *
+ * @return False if there's no room, see #URTCLIB_CHANGE_CALLBACKS
+ */
+bool uRTCLib::onChange(const uint8_t mask, void (*callback)(const uint8_t)) {
+	uint8_t i;
+	if (callback == NULL) {
+		for (i = 0; i < URTCLIB_CHANGE_CALLBACKS; i++) {
+			if (_change_masks[i] == mask) {
+				_change_callbacks[i] = NULL;
+			}
+		}
+		return true;
+	}
+	for (i = 0; i < URTCLIB_CHANGE_CALLBACKS; i++) {
+		if (_change_callbacks[i] == NULL) {
+			_change_masks[i] = mask;
+			_change_callbacks[i] = callback;
+			return true;
+		}
+	}
+	return false;
+}
+#endif
+
+/**
+ * \brief Waits for next RTC seconds increment and refreshes data just after it
+ *
+ * Polls seconds register (1 byte reads) up to 1.1 seconds. Useful to compare RTC against a reference with ms resolution.
+ *
+ * @param tickMillis millis() value when seconds increment was detected
+ *
+ * @return False on error or timeout
+ */
+bool uRTCLib::refreshOnTick(unsigned long *tickMillis) {
+	unsigned long start = millis();
+	int first = -1, current;
+	uint8_t second;
+	while (millis() - start < 1100) {
+		uRTCLIB_YIELD_WAIT
+		if (!_readRegisters(0x00, &second, 1)) {
+			return false;
+		}
+		current = second;
+		if (first < 0) {
+			first = current;
+		} else if (current != first) {
+			*tickMillis = millis();
+			return refresh();
+		}
+	}
+	return false;
+}
+
 /**
  * \brief Returns Enable Oscillator Flah
  *
@@ -396,44 +572,34 @@ void uRTCLib::lostPowerClear() {
 	switch (_model) {
 		case URTCLIB_MODEL_DS1307:
 			URTCLIB_WIRE.beginTransmission(_rtc_address);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(0x00);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.endTransmission();
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 			URTCLIB_WIRE.requestFrom(_rtc_address, 1);
 			status = URTCLIB_WIRE.read();
 			status &= 0b01111111;
 			URTCLIB_WIRE.beginTransmission(_rtc_address);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(0x00);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(status);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.endTransmission();
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 			break;
 
 		// case URTCLIB_MODEL_DS3231: // Commented out because it's default mode
 		// case URTCLIB_MODEL_DS3232: // Commented out because it's default mode
 		default:
 			URTCLIB_WIRE.beginTransmission(_rtc_address);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(0x0F);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.endTransmission();
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 			URTCLIB_WIRE.requestFrom(_rtc_address, 1);
 			status = URTCLIB_WIRE.read();
 			status &= 0b01111111;
 			URTCLIB_WIRE.beginTransmission(_rtc_address);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(0x0F);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(status);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.endTransmission();
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 			break;
 	}
 }
@@ -468,32 +634,25 @@ bool uRTCLib::enableBattery() {
 		default:
 			uint8_t status;
 			URTCLIB_WIRE.beginTransmission(_rtc_address);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(0x0E);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.endTransmission();
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 			URTCLIB_WIRE.requestFrom(_rtc_address, 1);
 			status = URTCLIB_WIRE.read();
 			status &= 0b01111111;
 			URTCLIB_WIRE.beginTransmission(_rtc_address);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(0x0E);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(status);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.endTransmission();
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 
 			// Return the status bit as a bool, to check against values of Control Register (0Eh)
 			URTCLIB_WIRE.beginTransmission(_rtc_address);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(0x0E);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.endTransmission();
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 			URTCLIB_WIRE.requestFrom(_rtc_address, 1);
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 			status =  URTCLIB_WIRE.read();
 			bool _eosc = (bool) (status & 0b10000000);
 			if(_eosc) _controlStatus |= 0b01000000;
@@ -524,30 +683,23 @@ bool uRTCLib::disableBattery() {
 		default:
 			uint8_t status;
 			URTCLIB_WIRE.beginTransmission(_rtc_address);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(0x0E);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.endTransmission();
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 			URTCLIB_WIRE.requestFrom(_rtc_address, 1);
 			status = URTCLIB_WIRE.read();
 			status |= 0b10000000;	// set eosc bit high to disable battery
 			URTCLIB_WIRE.beginTransmission(_rtc_address);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(0x0E);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(status);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.endTransmission();
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 
 			// Return the status bit as a bool, to check against values of Control Register (0Eh)
 			URTCLIB_WIRE.beginTransmission(_rtc_address);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(0x0E);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.endTransmission();
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 			URTCLIB_WIRE.requestFrom(_rtc_address, 1);
 			status =  URTCLIB_WIRE.read();
 			bool _eosc = (bool) (status & 0b10000000);
@@ -560,6 +712,63 @@ bool uRTCLib::disableBattery() {
 	return false;
 }
 
+#ifndef URTCLIB_NO_POWER_PROFILE
+/**
+ * \brief Sets power profile
+ *
+ * Control (0x0Eh) and Status (0x0Fh) registers are read and written in one burst each.
+ * On DS3231 only BBSQW is applied.
+ *
+ * @param profile Named profile or an OR of bits:
+ *	 - #URTCLIB_POWER_MAX_ACCURACY
+ *	 - #URTCLIB_POWER_BALANCED
+ *	 - #URTCLIB_POWER_MIN_DRAIN
+ *	 - #URTCLIB_POWER_CRATE_64S, #URTCLIB_POWER_CRATE_128S, #URTCLIB_POWER_CRATE_256S or #URTCLIB_POWER_CRATE_512S
+ *	 - #URTCLIB_POWER_BB32KHZ
+ *	 - #URTCLIB_POWER_BBSQW
+ *
+ * @return false on error or not supported (DS1307)
+ */
+bool uRTCLib::powerProfileSet(const uint8_t profile) {
+	uint8_t data[2], control, status;
+	if (_model == URTCLIB_MODEL_DS1307) {
+		return false;
+	}
+	if (!_readRegisters(0x0E, data, 2)) {
+		return false;
+	}
+	control = data[0];
+	status = data[1];
+	control = (control & 0b10111111) | ((profile & URTCLIB_POWER_BBSQW) << 3);
+	_power_profile = profile & URTCLIB_POWER_BBSQW;
+	data[0] = control;
+	if (_model != URTCLIB_MODEL_DS3232) {
+		// Nothing to change in status register, writing it back could clear a flag set after the read
+		return _writeRegisters(0x0E, data, 1);
+	}
+	// Writing 1 to OSF, A2F and A1F leaves them unchanged, so a flag set after the read is not lost
+	data[1] = (status & 0b00001100) | 0b10000011 | ((profile & 0b00000111) << 4);
+	_power_profile = profile & 0b00001111;
+	return _writeRegisters(0x0E, data, 2);
+}
+
+/**
+ * \brief Returns actual power profile
+ *
+ * See URTCLIB_POWER_XXXX defines. Compare with named profiles to check them.
+ *
+ * @return Current stored power profile. 0b11111111 means error (DS1307).
+ */
+uint8_t uRTCLib::powerProfile() {
+
+	if (_model == URTCLIB_MODEL_DS1307) {
+		return 0b11111111;
+	}
+	return _power_profile;
+}
+#endif
+
+#ifndef URTCLIB_NO_TEMP
 /**
  * \brief Returns actual temperature
  *
@@ -576,6 +785,120 @@ int16_t uRTCLib::temp() {
 	return _temp;
 }
 
+#ifndef URTCLIB_NO_TEMP_CONV
+/**
+ * \brief Starts an on-demand temperature conversion
+ *
+ * Temperature registers are updated automatically only every 64 seconds. This sets CONV bit on 0x0Eh
+ * unless a conversion is already running (BSY bit on 0x0Fh). Use tempReady() and tempRead() afterwards.
+ *
+ * Only DS3231 and DS3232.
+ *
+ * @return False on error or not supported (DS1307)
+ */
+bool uRTCLib::tempConvert() {
+	uint8_t data[2], control, status;
+	if (_model == URTCLIB_MODEL_DS1307) {
+		return false;
+	}
+	if (!_readRegisters(0x0E, data, 2)) {
+		return false;
+	}
+	control = data[0];
+	status = data[1];
+	_tempConvState = 1;
+	_tempConvStart = millis();
+	// Running conversion, automatic or not, will update registers anyway
+	if ((control & 0b00100000) || (status & 0b00000100)) {
+		return true;
+	}
+	URTCLIB_WIRE.beginTransmission(_rtc_address);
+	URTCLIB_WIRE.write(0x0E);
+	URTCLIB_WIRE.write(control | 0b00100000); // CONV
+	return URTCLIB_WIRE.endTransmission() == 0;
+}
+
+/**
+ * \brief Checks if temperature conversion started by tempConvert() has finished
+ *
+ * Non-blocking, a single 2 bytes read of 0x0Eh-0x0Fh (CONV and BSY). After #URTCLIB_TEMP_CONV_TIMEOUT ms conversion
+ * is given up: it returns false until next tempConvert() and tempTimedOut() returns true. Wait with
+ * while (!rtc.tempReady() && !rtc.tempTimedOut()).
+ *
+ * @return True when conversion is finished or none was started; false while running, after timeout or on error
+ */
+bool uRTCLib::tempReady() {
+	uint8_t data[2];
+	if (_tempConvState != 1) {
+		return _tempConvState == 0;
+	}
+	if (millis() - _tempConvStart > URTCLIB_TEMP_CONV_TIMEOUT) {
+		_tempConvState = 2;
+		return false;
+	}
+	if (!_readRegisters(0x0E, data, 2)) {
+		return false;
+	}
+	// CONV stays set until user conversion ends, BSY covers automatic ones
+	if ((data[0] & 0b00100000) || (data[1] & 0b00000100)) {
+		return false;
+	}
+	_tempConvState = 0;
+	return true;
+}
+
+/**
+ * \brief Checks if last temperature conversion was given up
+ *
+ * RTC didn't end it in #URTCLIB_TEMP_CONV_TIMEOUT ms, so temperature registers may hold an old value.
+ *
+ * @return True if last tempConvert() timed out
+ */
+bool uRTCLib::tempTimedOut() {
+	return _tempConvState == 2;
+}
+#endif
+
+/**
+ * \brief Reads only temperature registers (0x11h-0x12h)
+ *
+ * Updates value returned by temp() without a full refresh()
+ *
+ * @return False on error or not supported (DS1307)
+ */
+bool uRTCLib::tempRead() {
+	uint8_t data[2];
+	if (_model == URTCLIB_MODEL_DS1307) {
+		return false;
+	}
+	if (!_readRegisters(0x11, data, 2)) {
+		return false;
+	}
+	_temp = _tempDecode(data[0], data[1]);
+	#ifndef URTCLIB_NO_AGING_PROFILE
+	_agingProfileApply();
+	#endif
+	return true;
+}
+
+/**
+ * \brief Decodes temperature registers
+ *
+ * @param MSB 0x11h, 2's complement int portion
+ * @param LSB 0x12h, fraction portion
+ *
+ * @return Temperature as degrees * 100
+ */
+int16_t uRTCLib::_tempDecode(const uint8_t MSB, const uint8_t LSB) {
+	int16_t temp = 0b0000000000000000 | (MSB  << 2) | (LSB >> 6); // 8+2 bits, *25 is the same as number + 2bitdecimals * 100 in base 10
+	if (MSB & 0b10000000) {
+		temp = (temp | 0b1111110000000000);
+		temp--;
+	}
+	return temp * 25; // *25 is the same as number + 2bit (decimals) * 100 in base 10
+}
+#endif
+
 /**
  * \brief Returns actual second
  *
@@ -614,6 +937,9 @@ uint8_t uRTCLib::hour() {
  * @return byte with value 0, 1 or 2
  */
 uint8_t uRTCLib::hourModeAndAmPm() {
+	#ifdef URTCLIB_NO_12H
+	return 0;
+	#else
 	if((bool) (_controlStatus & 0b00100000)){		// _12hrMode = (bool) (_controlStatus & 0b00100000);
 		if((bool) (_controlStatus & 0b00010000))	// _pmNotAm = (bool) (_controlStatus & 0b00010000);
 			return 2;
@@ -622,6 +948,7 @@ uint8_t uRTCLib::hourModeAndAmPm() {
 	}
 	else
 		return 0;
+	#endif
 }
 
 /**
@@ -667,49 +994,491 @@ uint8_t uRTCLib::dayOfWeek() {
 	return _dayOfWeek;
 }
 
-
 /**
- * \brief Sets RTC i2 addres
+ * \brief Returns actual datetime as UNIX timestamp
  *
- * @param addr RTC i2C address
+ * Year is taken as 20xx. 12 hour mode is taken into account.
+ *
+ * @return Current stored datetime, seconds since 1970-01-01 00:00:00
  */
-void uRTCLib::set_rtc_address(const int addr) {
-	_rtc_address = addr;
+uint32_t uRTCLib::epoch() {
+	uint8_t hour = _hour;
+	#ifndef URTCLIB_NO_12H
+	if (_controlStatus & 0b00100000) { // _12hrMode
+		if (hour == 12) {
+			hour = 0;
+		}
+		if (_controlStatus & 0b00010000) { // _pmNotAm
+			hour += 12;
+		}
+	}
+	#endif
+	return _dateToUnix(_year, _month, _day, hour, _minute, _second);
 }
 
+/**
+ * \brief Writes actual datetime as text
+ *
+ * No printf and no allocation; digits are copied from a 2 digits table. 12 hour mode is taken into account.
+ *
+ * @param buffer Destination, at least #URTCLIB_FORMAT_LENGTH bytes
+ * @param style Text format:
+ *	 - #URTCLIB_FORMAT_ISO8601
+ *	 - #URTCLIB_FORMAT_COMPACT
+ *	 - #URTCLIB_FORMAT_12H
+ *
+ * @return Length written, excluding trailing NUL. 0 on wrong parameters.
+ */
+uint8_t uRTCLib::format(char *buffer, const uint8_t style) {
+	char *p = buffer;
+	uint8_t hour = _hour, mode = hourModeAndAmPm();
+	if (style > URTCLIB_FORMAT_12H) {
+		return 0;
+	}
+	if (style == URTCLIB_FORMAT_12H) {
+		if (mode == 0) { // 24 hour mode
+			mode = hour < 12 ? 1 : 2;
+			hour = hour % 12 == 0 ? 12 : hour % 12;
+		}
+	} else if (mode) { // 12 hour mode to 24
+		if (hour == 12) {
+			hour = 0;
+		}
+		if (mode == 2) {
+			hour += 12;
+		}
+	}
+	*p++ = '2';
+	*p++ = '0';
+	p = uRTCLib_putPair(p, _year);
+	if (style != URTCLIB_FORMAT_COMPACT) {
+		*p++ = '-';
+	}
+	p = uRTCLib_putPair(p, _month);
+	if (style != URTCLIB_FORMAT_COMPACT) {
+		*p++ = '-';
+	}
+	p = uRTCLib_putPair(p, _day);
+	*p++ = style == URTCLIB_FORMAT_12H ? ' ' : 'T';
+	p = uRTCLib_putPair(p, hour);
+	if (style != URTCLIB_FORMAT_COMPACT) {
+		*p++ = ':';
+	}
+	p = uRTCLib_putPair(p, _minute);
+	if (style != URTCLIB_FORMAT_COMPACT) {
+		*p++ = ':';
+	}
+	p = uRTCLib_putPair(p, _second);
+	if (style == URTCLIB_FORMAT_12H) {
+		*p++ = ' ';
+		*p++ = mode == 2 ? 'P' : 'A';
+		*p++ = 'M';
+	}
+	*p = '\0';
+	return p - buffer;
+}
 
 /**
- * \brief Sets RTC Model
+ * \brief Parses and validates an ISO 8601 datetime
  *
- * @param model RTC Model
- *	 - #URTCLIB_MODEL_DS1307
- *	 - #URTCLIB_MODEL_DS3231
- *	 - #URTCLIB_MODEL_DS3232
+ * Accepts extended (2024-01-31T23:59:50) and basic (20240131T235950) forms, with 'T' or space as separator and
+ * optional trailing 'Z'. Year must be 2000 to 2099. Day of week is computed.
+ *
+ * @param text Datetime text
+ * @param data 7 bytes filled in set() parameters order: second, minute, hour, day of week, day, month, year (last 2 digits)
+ *
+ * @return False if text is not valid
  */
-void uRTCLib::set_model(const uint8_t model) {
-	_model = model;
+bool uRTCLib::parse(const char *text, uint8_t *data) {
+	int8_t value[6];
+	const char *p = text + 2;
+	bool extended = false;
+	uint8_t i;
+	if (uRTCLib_getPair(text) != 20) {
+		return false;
+	}
+	for (i = 0; i < 6; i++) { // year, month, day, hour, minute, second
+		value[i] = uRTCLib_getPair(p);
+		if (value[i] < 0) {
+			return false;
+		}
+		p += 2;
+		if (i == 0) { // Checked here, so a short text is never read past its end
+			extended = *p == '-';
+		}
+		if (i == 2) {
+			if (*p != 'T' && *p != ' ') {
+				return false;
+			}
+			p++;
+		} else if (extended && i < 5) {
+			if (*p != (i < 2 ? '-' : ':')) {
+				return false;
+			}
+			p++;
+		}
+	}
+	if ((*p != '\0' && *p != 'Z') || (*p == 'Z' && p[1] != '\0')) {
+		return false;
+	}
+	if (value[1] < 1 || value[1] > 12 || value[2] < 1 || value[2] > _daysInMonth(value[1], value[0]) || value[3] > 23 || value[4] > 59 || value[5] > 59) {
+		return false;
+	}
+	data[0] = value[5];
+	data[1] = value[4];
+	data[2] = value[3];
+	data[3] = ((_dateToUnix(value[0], value[1], value[2], 0, 0, 0) / 86400UL + 4) % 7) + 1; // 1970-01-01 was Thursday; 1 = Sunday
+	data[4] = value[2];
+	data[5] = value[1];
+	data[6] = value[0];
+	return true;
 }
 
 /**
- * \brief Gets RTC Model
+ * \brief Sets RTC datetime from an ISO 8601 text
  *
- * @return RTC Model
- *	 - #URTCLIB_MODEL_DS1307
- *	 - #URTCLIB_MODEL_DS3231
- *	 - #URTCLIB_MODEL_DS3232
+ * See parse() for accepted forms.
+ *
+ * @param text Datetime text
+ *
+ * @return False if text is not valid, RTC is not changed
  */
-uint8_t uRTCLib::model() {
-	return _model;
+bool uRTCLib::setFromString(const char *text) {
+	uint8_t data[7];
+	if (!parse(text, data)) {
+		return false;
+	}
+	set(data[0], data[1], data[2], data[3], data[4], data[5], data[6]);
+	return true;
 }
 
 /**
- * \brief Sets RTC datetime data
+ * \brief Sets RTC to firmware build time if it's not set
  *
- * @param second second to set to HW RTC
- * @param minute minute to set to HW RTC
- * @param hour hour to set to HW RTC
- * @param dayOfWeek day of week to set to HW RTC
- *   - #URTCLIB_WEEKDAY_SUNDAY
+ * Refreshes RTC and, only if it lost power or its time is older than image, writes image in a single 7 bytes
+ * transaction (plus OSF clearing on DS3231/DS3232). Default image is #URTCLIB_BUILD_IMAGE, expanded where this is called,
+ * so it's sketch build time (build machine local time) with no runtime parsing.
+ *
+ * RTC ends late by the time between build and first boot; use setPrecise() when accuracy matters.
+ *
+ * @param image Registers image
+ *
+ * @return True if RTC was set
+ */
+bool uRTCLib::provisionIfUnset(const uRTCLibImage &image) {
+	uint32_t before, target = _registersToUnix(image.reg);
+	uint8_t data[7];
+	bool lost;
+	if (!refresh()) {
+		return false;
+	}
+	lost = lostPower();
+	before = epoch();
+	if (!lost && before >= target) {
+		return false;
+	}
+	if (!_writeRegisters(0, image.reg, 7)) {
+		return false;
+	}
+	uRTCLIB_YIELD_POINT
+	// DS1307 CH bit is already cleared by seconds register
+	if (lost && _model != URTCLIB_MODEL_DS1307) {
+		lostPowerClear();
+	}
+	_controlStatus &= 0b01111111;
+	_unixToDate(target, data);
+	data[3] = image.reg[3];
+	_setCache(data);
+	#ifndef URTCLIB_NO_MONOTONIC
+	if (_monotonic && !lost) {
+		_monotonicAdjust(before, target);
+	}
+	#endif
+	return true;
+}
+
+
+/**
+ * \brief Sets RTC i2 addres
+ *
+ * @param addr RTC i2C address
+ */
+void uRTCLib::set_rtc_address(const int addr) {
+	_rtc_address = addr;
+}
+
+
+/**
+ * \brief Sets RTC Model
+ *
+ * @param model RTC Model
+ *	 - #URTCLIB_MODEL_DS1307
+ *	 - #URTCLIB_MODEL_DS3231
+ *	 - #URTCLIB_MODEL_DS3232
+ */
+void uRTCLib::set_model(const uint8_t model) {
+	_model = model;
+}
+
+/**
+ * \brief Gets RTC Model
+ *
+ * @return RTC Model
+ *	 - #URTCLIB_MODEL_DS1307
+ *	 - #URTCLIB_MODEL_DS3231
+ *	 - #URTCLIB_MODEL_DS3232
+ */
+uint8_t uRTCLib::model() {
+	return _model;
+}
+
+#ifndef URTCLIB_NO_DETECT
+/**
+ * \brief Detects RTC Model
+ *
+ * Non-destructive probe using register pointer wrap-around: DS3231 wraps after 0x12h, DS3232 after 0xFFh
+ * and DS1307 after 0x3Fh. DS323x temperature LSB register has its 6 lower bits always 0.
+ * Uses 2 or 3 short reads. Result is cached and set as current model.
+ *
+ * @param force Probe again even if there's a cached result
+ *
+ * @return Detected model, #URTCLIB_MODEL_UNKNOWN if device doesn't answer or doesn't match any model
+ *	 - #URTCLIB_MODEL_DS1307
+ *	 - #URTCLIB_MODEL_DS3231
+ *	 - #URTCLIB_MODEL_DS3232
+ *	 - #URTCLIB_MODEL_UNKNOWN
+ */
+uint8_t uRTCLib::detect(const bool force) {
+	uint8_t time[2], probe[5], model = URTCLIB_MODEL_UNKNOWN, previous = _model, i;
+	bool temperature;
+	unsigned long start;
+	if (_detected_model != URTCLIB_MODEL_UNKNOWN && !force) {
+		return _detected_model;
+	}
+	start = micros();
+	_model = URTCLIB_MODEL_DS1307; // Model is not known yet, so probe at slowest clock
+
+	// 0x00h-0x01h: seconds and minutes, to compare with wrapped reads
+	if (_readRegisters(0x00, time, 2) && (time[0] & 0b00001111) <= 9 && (time[0] & 0b01110000) <= 0b01010000) {
+		// 0x11h-0x14h: DS3231 -> temp MSB, temp LSB, 0x00h, 0x01h. DS3232 -> temp MSB, temp LSB, 0x13h, SRAM. DS1307 -> SRAM
+		// A failed read leaves probe unset, so it doesn't count as a DS323x temperature either
+		temperature = _readRegisters(0x11, probe, 4) && !(probe[1] & 0b00111111);
+		if (temperature) {
+			// Seconds may increase between reads, so check again with a new read if needed
+			for (i = 0; i < 2 && model == URTCLIB_MODEL_UNKNOWN; i++) {
+				if (probe[2] == time[0] && probe[3] == time[1]) {
+					model = URTCLIB_MODEL_DS3231;
+				} else if (i == 0 && !_readRegisters(0x00, time, 2)) {
+					break;
+				}
+			}
+		}
+		// 0x3Fh-0x41h: DS1307 -> SRAM, 0x00h, 0x01h. DS3232 -> SRAM
+		if (model == URTCLIB_MODEL_UNKNOWN && _readRegisters(0x3F, probe + 2, 3)) {
+			for (i = 0; i < 2 && model == URTCLIB_MODEL_UNKNOWN; i++) {
+				if (probe[3] == time[0] && probe[4] == time[1]) {
+					model = URTCLIB_MODEL_DS1307;
+				} else if (i == 0 && !_readRegisters(0x00, time, 2)) {
+					break;
+				}
+			}
+			if (model == URTCLIB_MODEL_UNKNOWN && temperature) {
+				model = URTCLIB_MODEL_DS3232;
+			}
+		}
+	}
+
+	_detect_micros = micros() - start;
+	_detected_model = model;
+	_model = model != URTCLIB_MODEL_UNKNOWN ? model : previous;
+	return model;
+}
+
+/**
+ * \brief Returns time spent on last detection probe
+ *
+ * @return Time in microseconds
+ */
+unsigned long uRTCLib::detectMicros() {
+	return _detect_micros;
+}
+#endif
+
+#ifndef URTCLIB_NO_BUS_CLOCK
+/**
+ * \brief Declares I2C clock used by other devices on the bus
+ *
+ * When it's set and differs from maxClock(), register transfers (refresh(), RAM, snapshots, temperature...) switch
+ * the bus to maxClock() and back to this clock, 2 setClock() calls per transfer. Single register configuration
+ * changes run at bus clock. Default 0: bus clock is never changed.
+ *
+ * @param clock Bus clock in Hz, 0 to disable switching
+ */
+void uRTCLib::busClock(const uint32_t clock) {
+	_bus_clock = clock;
+}
+
+/**
+ * \brief Returns I2C clock declared with busClock(const uint32_t)
+ *
+ * @return Bus clock in Hz, 0 if switching is disabled
+ */
+uint32_t uRTCLib::busClock() {
+	return _bus_clock;
+}
+#endif
+
+/**
+ * \brief Returns maximum I2C clock of current model
+ *
+ * @return #URTCLIB_CLOCK_DS1307 or #URTCLIB_CLOCK_DS323X
+ */
+uint32_t uRTCLib::maxClock() {
+	switch (_model) {
+		case URTCLIB_MODEL_DS1307:
+			return URTCLIB_CLOCK_DS1307;
+
+		// case URTCLIB_MODEL_DS3231: // Commented out because it's default mode
+		// case URTCLIB_MODEL_DS3232: // Commented out because it's default mode
+		default:
+			return URTCLIB_CLOCK_DS323X;
+	}
+}
+
+#ifndef URTCLIB_NO_BUS_CLOCK
+/**
+ * \brief Switches bus to device clock or back to bus clock, see busClock()
+ *
+ * @param device True to switch to maxClock(), false to go back to busClock()
+ *
+ * @return True if clock was changed
+ */
+bool uRTCLib::_clockSwitch(const bool device) {
+	if (_bus_clock == 0 || _bus_clock == maxClock()) {
+		return false;
+	}
+	URTCLIB_WIRE_CLOCK(device ? maxClock() : _bus_clock);
+	return true;
+}
+#endif
+
+/**
+ * \brief Reads consecutive registers
+ *
+ * Register pointer is set once and read in #URTCLIB_WIRE_BURST bytes transactions; RTC keeps incrementing
+ * it between them. Runs at maxClock() when busClock() is set.
+ *
+ * @param address First register
+ * @param data Buffer to store content
+ * @param length Number of registers to read
+ *
+ * @return False on error
+ */
+bool uRTCLib::_readRegisters(const uint8_t address, uint8_t *data, const uint16_t length) {
+	#ifdef URTCLIB_NO_BUS_CLOCK
+	return _readChunks(address, data, length);
+	#else
+	bool ret, switched = _clockSwitch(true);
+	ret = _readChunks(address, data, length);
+	if (switched) {
+		_clockSwitch(false);
+	}
+	return ret;
+	#endif
+}
+
+/**
+ * \brief Reads consecutive registers at current bus clock, see _readRegisters()
+ *
+ * @param address First register
+ * @param data Buffer to store content
+ * @param length Number of registers to read
+ *
+ * @return False on error
+ */
+bool uRTCLib::_readChunks(const uint8_t address, uint8_t *data, const uint16_t length) {
+	uint16_t done = 0;
+	uint8_t chunk;
+	uRTCLIB_YIELD_POINT
+	URTCLIB_WIRE.beginTransmission(_rtc_address);
+	URTCLIB_WIRE.write(address);
+	if (URTCLIB_WIRE.endTransmission() != 0) {
+		return false;
+	}
+	while (done < length) {
+		chunk = length - done > URTCLIB_WIRE_BURST ? URTCLIB_WIRE_BURST : length - done;
+		uRTCLIB_YIELD_POINT
+		if (!URTCLIB_WIRE_RECEIVED(URTCLIB_WIRE.requestFrom(_rtc_address, chunk), chunk)) {
+			return false;
+		}
+		while (chunk--) {
+			data[done++] = URTCLIB_WIRE.read();
+		}
+	}
+	return true;
+}
+
+/**
+ * \brief Writes consecutive registers
+ *
+ * Writes in #URTCLIB_WIRE_BURST bytes transactions, register address included. Runs at maxClock() when busClock() is set.
+ *
+ * @param address First register
+ * @param data Content to write
+ * @param length Number of registers to write
+ *
+ * @return False on error
+ */
+bool uRTCLib::_writeRegisters(const uint8_t address, const uint8_t *data, const uint16_t length) {
+	#ifdef URTCLIB_NO_BUS_CLOCK
+	return _writeChunks(address, data, length);
+	#else
+	bool ret, switched = _clockSwitch(true);
+	ret = _writeChunks(address, data, length);
+	if (switched) {
+		_clockSwitch(false);
+	}
+	return ret;
+	#endif
+}
+
+/**
+ * \brief Writes consecutive registers at current bus clock, see _writeRegisters()
+ *
+ * @param address First register
+ * @param data Content to write
+ * @param length Number of registers to write
+ *
+ * @return False on error
+ */
+bool uRTCLib::_writeChunks(const uint8_t address, const uint8_t *data, const uint16_t length) {
+	uint16_t done = 0;
+	uint8_t chunk;
+	while (done < length) {
+		chunk = length - done > URTCLIB_WIRE_BURST - 1 ? URTCLIB_WIRE_BURST - 1 : length - done;
+		uRTCLIB_YIELD_POINT
+		URTCLIB_WIRE.beginTransmission(_rtc_address);
+		URTCLIB_WIRE.write((uint8_t) (address + done));
+		while (chunk--) {
+			URTCLIB_WIRE.write(data[done++]);
+		}
+		if (URTCLIB_WIRE.endTransmission() != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * \brief Sets RTC datetime data
+ *
+ * Cached datetime is updated too, so there's no need to refresh(). RTC is left in 24 hour mode.
+ *
+ * @param second second to set to HW RTC
+ * @param minute minute to set to HW RTC
+ * @param hour hour to set to HW RTC
+ * @param dayOfWeek day of week to set to HW RTC
+ *   - #URTCLIB_WEEKDAY_SUNDAY
  *   - #URTCLIB_WEEKDAY_MONDAY
  *   - #URTCLIB_WEEKDAY_TUESDAY
  *   - #URTCLIB_WEEKDAY_WEDNESDAY
@@ -721,7 +1490,12 @@ uint8_t uRTCLib::model() {
  * @param year year to set to HW RTC in last 2 digits mode. As RTCs only support 19xx and 20xx years (see datasheets), it's harcoded to 20xx.
  */
 void uRTCLib::set(const uint8_t second, const uint8_t minute, const uint8_t hour, const uint8_t dayOfWeek, const uint8_t dayOfMonth, const uint8_t month, const uint8_t year) {
-	uRTCLIB_YIELD
+	#ifndef URTCLIB_NO_MONOTONIC
+	uint32_t before = 0;
+	bool known = _monotonic && _readEpoch(&before);
+	#endif
+	uint8_t data[7] = { second, minute, hour, dayOfWeek, dayOfMonth, month, year };
+	uRTCLIB_YIELD_POINT
 	URTCLIB_WIRE.beginTransmission(_rtc_address);
 	URTCLIB_WIRE.write(0); // set next input to start at the seconds register
 	URTCLIB_WIRE.write(uRTCLIB_decToBcd(second)); // set seconds
@@ -732,17 +1506,23 @@ void uRTCLib::set(const uint8_t second, const uint8_t minute, const uint8_t hour
 	URTCLIB_WIRE.write(0B10000000 | uRTCLIB_decToBcd(month)); // set month
 	URTCLIB_WIRE.write(uRTCLIB_decToBcd(year)); // set year (0 to 99)
 	URTCLIB_WIRE.endTransmission();
-	uRTCLIB_YIELD
+	uRTCLIB_YIELD_POINT
+	_setCache(data);
+	#ifndef URTCLIB_NO_MONOTONIC
+	if (known) {
+		_monotonicAdjust(before, epoch());
+	}
+	#endif
 	//
 	URTCLIB_WIRE.beginTransmission(_rtc_address);
 	URTCLIB_WIRE.write(0X0F);
 	URTCLIB_WIRE.endTransmission();
-	uRTCLIB_YIELD
+	uRTCLIB_YIELD_POINT
 	/* flip OSF bit --> Disabled, use lostPowerClear instead.
 	URTCLIB_WIRE.requestFrom(_rtc_address, 1);
 	uint8_t statreg = URTCLIB_WIRE.read();
 	statreg &= ~0x80;
-	uRTCLIB_YIELD
+	uRTCLIB_YIELD_POINT
 	URTCLIB_WIRE.beginTransmission(_rtc_address);
 	URTCLIB_WIRE.write(0X0F);
 	URTCLIB_WIRE.write((byte)statreg);
@@ -750,6 +1530,7 @@ void uRTCLib::set(const uint8_t second, const uint8_t minute, const uint8_t hour
 	*/
 }
 
+#ifndef URTCLIB_NO_12H
 /**
  * \brief Set clock in 12 or 24 hour mode
  * 12 hour mode has 1-12 hours and AM or PM flag
@@ -762,6 +1543,10 @@ void uRTCLib::set_12hour_mode(const bool twelveHrMode) {
 	bool currentMode12Hr = (bool) (_controlStatus & 0b00100000);
 	if((currentMode12Hr && twelveHrMode) || (!currentMode12Hr && !twelveHrMode))	// already in same mode, return
 		return;
+	#ifndef URTCLIB_NO_MONOTONIC
+	uint32_t before = 0;
+	bool known = _monotonic && _readEpoch(&before);
+	#endif
 	bool _pmNotAm = (bool) (_controlStatus & 0b00010000);
 	if(twelveHrMode && !currentMode12Hr) {
 		// current Mode is 24 hour
@@ -812,21 +1597,384 @@ void uRTCLib::set_12hour_mode(const bool twelveHrMode) {
 		_controlStatus &= 0b11011111;
 	}
 	// set hour register byte
-	uRTCLIB_YIELD
+	uRTCLIB_YIELD_POINT
 	URTCLIB_WIRE.beginTransmission(_rtc_address);
 	URTCLIB_WIRE.write(0x02); // set next input to start at the hours register
 	URTCLIB_WIRE.write(hour_bcd); // set hours
 	URTCLIB_WIRE.endTransmission();
-	uRTCLIB_YIELD
+	uRTCLIB_YIELD_POINT
+	// Hour is written from cached data, so it's a jump if cache was old
+	#ifndef URTCLIB_NO_MONOTONIC
+	if (known) {
+		_monotonicAdjust(before, epoch());
+	}
+	#endif
 	//
 	URTCLIB_WIRE.beginTransmission(_rtc_address);
 	URTCLIB_WIRE.write(0X0F);
 	URTCLIB_WIRE.endTransmission();
-	uRTCLIB_YIELD
+	uRTCLIB_YIELD_POINT
+}
+#endif
+
+#ifndef URTCLIB_NO_PRECISE_SET
+/**
+ * \brief Sets RTC datetime data synchronized to a reference instant
+ *
+ * Given datetime is the exact time at refMicros (a micros() value). BCD payload is prepared in advance,
+ * I2C transfer time is measured and the write is issued so it ends on a whole second boundary of the
+ * reference. As RTC resets its internal divider chain on seconds write, new second phase matches reference.
+ * When busClock() is set, bus stays at maxClock() from measurement to write, so both run at the same clock.
+ *
+ * Datetime written is the given one plus the elapsed whole seconds, so refMicros must be less than ~70 minutes old.
+ *
+ * @param second second at refMicros
+ * @param minute minute at refMicros
+ * @param hour hour at refMicros
+ * @param dayOfWeek day of week at refMicros
+ * @param dayOfMonth day of month at refMicros
+ * @param month month at refMicros
+ * @param year year at refMicros in last 2 digits mode
+ * @param refMicros micros() value when given datetime was exact
+ *
+ * @return False on error
+ */
+bool uRTCLib::setPrecise(const uint8_t second, const uint8_t minute, const uint8_t hour, const uint8_t dayOfWeek, const uint8_t dayOfMonth, const uint8_t month, const uint8_t year, const unsigned long refMicros) {
+	uint8_t data[7], i, dow;
+	uint32_t base, target;
+	unsigned long start, elapsed, seconds;
+	bool ok;
+	#ifndef URTCLIB_NO_BUS_CLOCK
+	bool switched;
+	#endif
+	#ifndef URTCLIB_NO_MONOTONIC
+	uint32_t before;
+	unsigned long measured;
+	#endif
+	#if URTCLIB_YIELD_POLICY != URTCLIB_YIELD_NONE
+	uint8_t policy = _yield_policy;
+	#endif
+
+	// Measure transfer time with a harmless transaction of similar length: 2 + 8 bytes read vs 9 bytes write
+	uRTCLIB_YIELD_POINT
+	#ifndef URTCLIB_NO_BUS_CLOCK
+	switched = _clockSwitch(true); // Measurement and write at the same clock, until write ends
+	#endif
+	#if URTCLIB_YIELD_POLICY != URTCLIB_YIELD_NONE
+	_yield_policy = URTCLIB_YIELD_NONE; // Time spent on yields would be taken as transfer time
+	#endif
+	start = micros();
+	ok = _readChunks(0, data, 7);
+	_setLatencyMicros = (micros() - start) * 9 / 10;
+	#if URTCLIB_YIELD_POLICY != URTCLIB_YIELD_NONE
+	_yield_policy = policy;
+	#endif
+	if (!ok) {
+		#ifndef URTCLIB_NO_BUS_CLOCK
+		if (switched) {
+			_clockSwitch(false);
+		}
+		#endif
+		return false;
+	}
+	#ifndef URTCLIB_NO_MONOTONIC
+	before = _registersToUnix(data);
+	measured = start;
+	#endif
+
+	// Select next reachable second boundary
+	elapsed = micros() - refMicros;
+	seconds = elapsed / 1000000UL + 1;
+	if (seconds * 1000000UL - elapsed < _setLatencyMicros + URTCLIB_PRECISE_SET_MARGIN) {
+		seconds++;
+	}
+
+	// Pre-compute payload for that boundary, keeping caller's day of week convention
+	base = _dateToUnix(year, month, dayOfMonth, hour, minute, second);
+	target = base + seconds;
+	_unixToDate(target, data);
+	dow = ((dayOfWeek - 1 + (target / 86400UL - base / 86400UL)) % 7) + 1;
+	data[3] = dow;
+	for (i = 0; i < 7; i++) {
+		data[i] = uRTCLIB_decToBcd(data[i]);
+	}
+	data[5] |= 0B10000000; // century bit, as set()
+
+	URTCLIB_WIRE.beginTransmission(_rtc_address);
+	URTCLIB_WIRE.write(0); // set next input to start at the seconds register
+	for (i = 0; i < 7; i++) {
+		URTCLIB_WIRE.write(data[i]);
+	}
+
+	// Transfer happens on endTransmission, so start it one transfer time before the boundary
+	_setBoundaryMicros = refMicros + seconds * 1000000UL;
+	start = _setBoundaryMicros - _setLatencyMicros;
+	while ((long) (micros() - start) < -2000L) {
+		uRTCLIB_YIELD_WAIT
+	}
+	while ((long) (micros() - start) < 0) { }
+	ok = URTCLIB_WIRE.endTransmission() == 0;
+	#ifndef URTCLIB_NO_BUS_CLOCK
+	if (switched) {
+		_clockSwitch(false);
+	}
+	#endif
+	if (!ok) {
+		return false;
+	}
+	_unixToDate(target, data);
+	data[3] = dow;
+	_setCache(data);
+	#ifndef URTCLIB_NO_MONOTONIC
+	if (_monotonic) {
+		// RTC time at write, rounded to nearest second as RTC phase is unknown
+		_monotonicAdjust(before + (_setBoundaryMicros - measured + 500000UL) / 1000000UL, target);
+	}
+	#endif
+	return true;
+}
+
+/**
+ * \brief Measures phase error of last setPrecise() call
+ *
+ * SQWG must be set to #URTCLIB_SQWG_1H and its pin connected to sqwPin. DS3231/DS3232 falling edge marks seconds update.
+ * Blocks until next falling edge, 1.5 seconds maximum.
+ *
+ * @param sqwPin MCU pin connected to SQW output
+ *
+ * @return Phase error in microseconds, positive when RTC is late. #URTCLIB_PHASE_ERROR if no edge is seen.
+ */
+long uRTCLib::setPhaseError(const uint8_t sqwPin) {
+	unsigned long start = millis(), edge;
+	int previous = digitalRead(sqwPin), current;
+	long phase;
+	while (millis() - start < 1500) {
+		current = digitalRead(sqwPin);
+		if (previous == HIGH && current == LOW) {
+			edge = micros();
+			phase = (long) ((edge - _setBoundaryMicros) % 1000000UL);
+			if (phase > 500000L) {
+				phase -= 1000000L;
+			}
+			return phase;
+		}
+		previous = current;
+	}
+	return URTCLIB_PHASE_ERROR;
+}
+
+/**
+ * \brief Returns I2C transfer time compensated on last setPrecise() call
+ *
+ * @return transfer time in microseconds
+ */
+unsigned long uRTCLib::setLatency() {
+	return _setLatencyMicros;
+}
+#endif
+
+#ifndef URTCLIB_NO_MONOTONIC
+/**
+ * \brief Enables monotonic seconds counter
+ *
+ * From now on set(), set_12hour_mode() and setPrecise() read RTC time before writing and add the jump to an
+ * offset, stored on RTC RAM (DS1307 and DS3232) so it survives MCU resets. On DS3231 it's only kept on MCU RAM.
+ *
+ * @return True if a stored offset was found; always false on DS3231
+ */
+bool uRTCLib::monotonicBegin() {
+	_monotonic = true;
+	_monotonicOffset = 0;
+	#ifndef URTCLIB_NO_RAM
+	byte data[5];
+	uint8_t j;
+	if (_ramOffset(URTCLIB_MONOTONIC_RAM_ADDRESS, 5) == 0xff) { // No RAM
+		return false;
+	}
+	if (ramReadBlock(URTCLIB_MONOTONIC_RAM_ADDRESS, data, 5) && data[0] == URTCLIB_MONOTONIC_MAGIC) {
+		for (j = 0; j < 4; j++) {
+			_monotonicOffset |= (uint32_t) data[1 + j] << (8 * j);
+		}
+		return true;
+	}
+	_monotonicAdjust(0, 0); // Store initial offset
+	#endif
+	return false;
+}
+
+/**
+ * \brief Returns monotonic seconds counter
+ *
+ * Cached RTC time plus offset, so it doesn't access I2C bus; call refresh() as usual. Never decreases while MCU runs.
+ *
+ * @return Seconds, not affected by clock changes
+ */
+uint32_t uRTCLib::monotonic() {
+	uint32_t value = epoch() + _monotonicOffset;
+	if (value < _monotonicLast) { // i.e. RTC lost power and restarted at 2000
+		value = _monotonicLast;
+	}
+	_monotonicLast = value;
+	return value;
+}
+
+/**
+ * \brief Returns monotonic offset
+ *
+ * @return Seconds added to RTC time by monotonic()
+ */
+int32_t uRTCLib::monotonicOffset() {
+	return _monotonicOffset;
+}
+
+/**
+ * \brief Reads RTC time registers only
+ *
+ * @param timestamp Where to store RTC time, UNIX timestamp
+ *
+ * @return False on error
+ */
+bool uRTCLib::_readEpoch(uint32_t *timestamp) {
+	uint8_t data[7];
+	if (!_readRegisters(0, data, 7)) {
+		return false;
+	}
+	*timestamp = _registersToUnix(data);
+	return true;
+}
+
+/**
+ * \brief Adds a clock jump to monotonic offset and stores it
+ *
+ * @param before RTC time just before the change
+ * @param after RTC time just after the change
+ */
+void uRTCLib::_monotonicAdjust(const uint32_t before, const uint32_t after) {
+	_monotonicOffset += (int32_t) (before - after);
+	#ifndef URTCLIB_NO_RAM
+	byte data[5];
+	uint8_t j;
+	data[0] = URTCLIB_MONOTONIC_MAGIC;
+	for (j = 0; j < 4; j++) {
+		data[1 + j] = (uint32_t) _monotonicOffset >> (8 * j);
+	}
+	if (_ramOffset(URTCLIB_MONOTONIC_RAM_ADDRESS, 5) == 0xff) { // DS3231, kept on MCU RAM only
+		return;
+	}
+	ramWriteBlock(URTCLIB_MONOTONIC_RAM_ADDRESS, data, 5);
+	#endif
+}
+#endif
+
+/**
+ * \brief Updates cached datetime after writing it
+ *
+ * @param data 7 bytes in RTC register order, decimal and 24 hour mode: second, minute, hour, day of week, day, month, year
+ */
+void uRTCLib::_setCache(const uint8_t *data) {
+	_second = data[0];
+	_minute = data[1];
+	_hour = data[2];
+	_dayOfWeek = data[3];
+	_day = data[4];
+	_month = data[5];
+	_year = data[6];
+	_controlStatus &= 0b11001111; // Written in 24 hour mode
 }
 
 
 
+/*************  Date helpers: ****************/
+
+/**
+ * \brief Days of a month
+ *
+ * @param month month, 1 to 12
+ * @param year year in last 2 digits mode (20xx)
+ *
+ * @return Number of days
+ */
+uint8_t uRTCLib::_daysInMonth(const uint8_t month, const uint8_t year) {
+	if (month == 2) {
+		return (year & 0b00000011) ? 28 : 29;
+	}
+	return 30 + ((month + (month >> 3)) & 1);
+}
+
+/**
+ * \brief Converts a 20xx datetime to UNIX timestamp
+ *
+ * @param year year in last 2 digits mode
+ * @param month month
+ * @param day day of month
+ * @param hour hour, 24h
+ * @param minute minute
+ * @param second second
+ *
+ * @return Seconds since 1970-01-01 00:00:00
+ */
+uint32_t uRTCLib::_dateToUnix(const uint8_t year, const uint8_t month, const uint8_t day, const uint8_t hour, const uint8_t minute, const uint8_t second) {
+	uint32_t days = 10957UL + year * 365UL + (year + 3) / 4; // 1970 to 2000, years and past leap days
+	for (uint8_t m = 1; m < month; m++) {
+		days += _daysInMonth(m, year);
+	}
+	days += day - 1;
+	return ((days * 24UL + hour) * 60UL + minute) * 60UL + second;
+}
+
+/**
+ * \brief Converts UNIX timestamp to 20xx datetime
+ *
+ * @param timestamp Seconds since 1970-01-01 00:00:00, 2000 or later
+ * @param data 7 bytes buffer filled in RTC register order, decimal: second, minute, hour, day of week, day, month, year
+ */
+void uRTCLib::_unixToDate(uint32_t timestamp, uint8_t *data) {
+	uint32_t days = timestamp / 86400UL;
+	timestamp -= days * 86400UL;
+	data[0] = timestamp % 60;
+	data[1] = (timestamp / 60) % 60;
+	data[2] = timestamp / 3600;
+	data[3] = ((days + 4) % 7) + 1; // 1970-01-01 was Thursday; 1 = Sunday
+	days -= 10957UL;
+	data[6] = 0;
+	while (days >= (uint32_t) ((data[6] & 0b00000011) ? 365 : 366)) {
+		days -= (data[6] & 0b00000011) ? 365 : 366;
+		data[6]++;
+	}
+	data[5] = 1;
+	while (days >= _daysInMonth(data[5], data[6])) {
+		days -= _daysInMonth(data[5], data[6]);
+		data[5]++;
+	}
+	data[4] = days + 1;
+}
+
+/**
+ * \brief Converts raw RTC time registers to UNIX timestamp
+ *
+ * @param data 7 bytes as read from RTC, starting at 0x00h
+ *
+ * @return Seconds since 1970-01-01 00:00:00
+ */
+uint32_t uRTCLib::_registersToUnix(const uint8_t *data) {
+	uint8_t hour = uRTCLIB_bcdToDec((data[2] & 0b00111111));
+	#ifndef URTCLIB_NO_12H
+	if (data[2] & 0b01000000) { // 12 hour mode
+		hour = uRTCLIB_bcdToDec((data[2] & 0b00011111));
+		if (hour == 12) {
+			hour = 0;
+		}
+		if (data[2] & 0b00100000) { // PM
+			hour += 12;
+		}
+	}
+	#endif
+	return _dateToUnix(uRTCLIB_bcdToDec(data[6]), uRTCLIB_bcdToDec((data[5] & 0b00011111)), uRTCLIB_bcdToDec(data[4]), hour, uRTCLIB_bcdToDec((data[1] & 0b01111111)), uRTCLIB_bcdToDec((data[0] & 0b01111111)));
+}
+
+
+
+#ifndef URTCLIB_NO_ALARMS
 /*************  Alarms: ****************/
 
 
@@ -862,144 +2010,117 @@ bool uRTCLib::alarmSet(const uint8_t type, const uint8_t second, const uint8_t m
 	if (_model == URTCLIB_MODEL_DS1307) {
 		return false;
 	}
-	uRTCLIB_YIELD
+	uRTCLIB_YIELD_POINT
 
 	if (type == URTCLIB_ALARM_TYPE_1_NONE) {
 		ret = true;
 
 		// Disable Alarm:
 		URTCLIB_WIRE.beginTransmission(_rtc_address);
-		uRTCLIB_YIELD
 		URTCLIB_WIRE.write(0x0E);
-		uRTCLIB_YIELD
 		URTCLIB_WIRE.endTransmission();
-		uRTCLIB_YIELD
+		uRTCLIB_YIELD_POINT
 		URTCLIB_WIRE.requestFrom(_rtc_address, 1);
 		status = URTCLIB_WIRE.read();
 		status &= 0b11111110;
 		URTCLIB_WIRE.beginTransmission(_rtc_address);
-		uRTCLIB_YIELD
 		URTCLIB_WIRE.write(0x0E);
-		uRTCLIB_YIELD
 		URTCLIB_WIRE.write(status);
-		uRTCLIB_YIELD
 		URTCLIB_WIRE.endTransmission();
-		uRTCLIB_YIELD
+		uRTCLIB_YIELD_POINT
 		_a1_mode = type;
 	} else if (type == URTCLIB_ALARM_TYPE_2_NONE) {
 		ret = true;
 
 		// Disable Alarm:
 		URTCLIB_WIRE.beginTransmission(_rtc_address);
-		uRTCLIB_YIELD
 		URTCLIB_WIRE.write(0x0E);
-		uRTCLIB_YIELD
 		URTCLIB_WIRE.endTransmission();
-		uRTCLIB_YIELD
+		uRTCLIB_YIELD_POINT
 		URTCLIB_WIRE.requestFrom(_rtc_address, 1);
 		status = URTCLIB_WIRE.read();
 		status &= 0b11111101;
 		URTCLIB_WIRE.beginTransmission(_rtc_address);
-		uRTCLIB_YIELD
 		URTCLIB_WIRE.write(0x0E);
-		uRTCLIB_YIELD
 		URTCLIB_WIRE.write(status);
-		uRTCLIB_YIELD
 		URTCLIB_WIRE.endTransmission();
-		uRTCLIB_YIELD
+		uRTCLIB_YIELD_POINT
 		_a2_mode = type;
 	} else {
 		switch (type & 0b10000000) {
 			case 0b00000000: // Alarm 1
 				ret = true;
 				URTCLIB_WIRE.beginTransmission(_rtc_address);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(0x07); // set next input to start at the seconds register
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write((uRTCLIB_decToBcd(second) & 0b01111111) | ((type & 0b00000001) << 7)); // set seconds & mode/bit1
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write((uRTCLIB_decToBcd(minute) & 0b01111111) | ((type & 0b00000010) << 6)); // set minutes & mode/bit2
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write((uRTCLIB_decToBcd(hour) & 0b00111111) | ((type & 0b00000100) << 5)); // set hours & mode/bit3
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write((uRTCLIB_decToBcd(day_dow) & 0b00111111) | ((type & 0b00001000) << 4) | ((type & 0b00010000) << 2)); // set date / day of week (1=Sunday, 7=Saturday)  & mode/bit4 & mode/DY-DT
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.endTransmission();
-				uRTCLIB_YIELD
+				uRTCLIB_YIELD_POINT
 
 				// Enable Alarm:
 				URTCLIB_WIRE.beginTransmission(_rtc_address);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(0x0E);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.endTransmission();
-				uRTCLIB_YIELD
+				uRTCLIB_YIELD_POINT
 				URTCLIB_WIRE.requestFrom(_rtc_address, 1);
-				uRTCLIB_YIELD
+				uRTCLIB_YIELD_POINT
 				status = URTCLIB_WIRE.read();
 				status = status | 0b00000101;  // INTCN and A1IE bits
 				URTCLIB_WIRE.beginTransmission(_rtc_address);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(0x0E);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(status);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.endTransmission();
-				uRTCLIB_YIELD
+				uRTCLIB_YIELD_POINT
 
 				_a1_mode = type;
 				_a1_second = second;
 				_a1_minute = minute;
 				_a1_hour = hour;
 				_a1_day_dow = day_dow;
+				#ifndef URTCLIB_NO_SQWG
 				_sqwg_mode = URTCLIB_SQWG_OFF_1;
+				#endif
 
 				break;
 
 			case 0b10000000: // Alarm 2
 				ret = true;
 				URTCLIB_WIRE.beginTransmission(_rtc_address);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(0x0B); // set next input to start at the minutes register
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write((uRTCLIB_decToBcd(minute) & 0b01111111) | ((type & 0b00000010) << 6)); // set minutes & mode/bit2
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write((uRTCLIB_decToBcd(hour) & 0b00111111) | ((type & 0b00000100) << 5)); // set hours & mode/bit3
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write((uRTCLIB_decToBcd(day_dow) & 0b00111111) | ((type & 0b00001000) << 4) | ((type & 0b00010000) << 2)); // set date / day of week (1=Sunday, 7=Saturday)  & mode/bit4 & mode/DY-DT (bit3)
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.endTransmission();
-				uRTCLIB_YIELD
+				uRTCLIB_YIELD_POINT
 
 				// Enable Alarm:
 				URTCLIB_WIRE.beginTransmission(_rtc_address);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(0x0E);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.endTransmission();
-				uRTCLIB_YIELD
+				uRTCLIB_YIELD_POINT
 				URTCLIB_WIRE.requestFrom(_rtc_address, 1);
-				uRTCLIB_YIELD
+				uRTCLIB_YIELD_POINT
 				status = URTCLIB_WIRE.read();
 				status = status | 0b00000110;  // INTCN and A2IE bits
 				URTCLIB_WIRE.beginTransmission(_rtc_address);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(0x0E);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(status);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.endTransmission();
-				uRTCLIB_YIELD
+				uRTCLIB_YIELD_POINT
 
 				_a2_mode = type;
 				_a2_minute = minute;
 				_a2_hour = hour;
 				_a2_day_dow = day_dow;
+				#ifndef URTCLIB_NO_SQWG
 				_sqwg_mode = URTCLIB_SQWG_OFF_1;
+				#endif
 
 				break;
 		} // Alarm type switch
-		uRTCLIB_YIELD
+		uRTCLIB_YIELD_POINT
 	} // if..else
 	return ret;
 }
@@ -1039,22 +2160,17 @@ bool uRTCLib::alarmDisable(const uint8_t alarm) {
 			if (mask) {
 				// Disable Alarm:
 				URTCLIB_WIRE.beginTransmission(_rtc_address);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(0x0E);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.endTransmission();
-				uRTCLIB_YIELD
+				uRTCLIB_YIELD_POINT
 				URTCLIB_WIRE.requestFrom(_rtc_address, 1);
 				status = URTCLIB_WIRE.read();
 				status &= mask;  // A1IE or A2IE bit
 				URTCLIB_WIRE.beginTransmission(_rtc_address);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(0x0E);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(status);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.endTransmission();
-				uRTCLIB_YIELD
+				uRTCLIB_YIELD_POINT
 				return true;
 			}
 			break;
@@ -1094,23 +2210,18 @@ bool uRTCLib::alarmClearFlag(const uint8_t alarm) {
 			if (mask) {
 				// Clear Alarm Flag:
 				URTCLIB_WIRE.beginTransmission(_rtc_address);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(0x0F);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.endTransmission();
-				uRTCLIB_YIELD
+				uRTCLIB_YIELD_POINT
 				URTCLIB_WIRE.requestFrom(_rtc_address, 1);
 				status = URTCLIB_WIRE.read();
 				status &= mask;  // A?F bit
 				_controlStatus &= mask;	// clear alarm triggered flags on _controlStatus as well
 				URTCLIB_WIRE.beginTransmission(_rtc_address);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(0x0F);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(status);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.endTransmission();
-				uRTCLIB_YIELD
+				uRTCLIB_YIELD_POINT
 				return true;
 			}
 			break;
@@ -1266,68 +2377,378 @@ uint8_t uRTCLib::alarmHour(const uint8_t alarm) {
 }
 
 /**
- * \brief Returns actual alarm day or DOW
+ * \brief Returns actual alarm day or DOW
+ *
+ * @param alarm Alarm number:
+ *	 - #URTCLIB_ALARM_1
+ *	 - #URTCLIB_ALARM_2
+ *
+ * @return Current stored day or dow. 0b11111111 means error.
+ */
+uint8_t uRTCLib::alarmDayDow(const uint8_t alarm) {
+	switch (_model) {
+		case URTCLIB_MODEL_DS1307:
+			return 0b11111111;
+			break;
+
+		// case URTCLIB_MODEL_DS3231: // Commented out because it's default mode
+		// case URTCLIB_MODEL_DS3232: // Commented out because it's default mode
+		default:
+			switch (alarm) {
+				case URTCLIB_ALARM_1: // Alarm 1
+					return _a1_day_dow;
+					break;
+
+				case URTCLIB_ALARM_2: // Alarm 2
+					return _a2_day_dow;
+					break;
+			} // Alarm type switch
+			break;
+	} // model switch
+	return 0b11111111;
+}
+
+
+/**
+* \brief Checks if any alarm has been triggered
+*
+* NOTE: Alarm Flags A1F and A2F will be triggered whether or not Alarm Interrupt is Enabled A1IE and A2IE
+* When the RTC register values match alarm register settings, the corresponding Alarm Flag ‘A1F’ or ‘A2F’ bit is set to logic 1.
+* If using alarmTriggered function to check for alarm trigger, be sure to alarmMode function to see if alarm is enabled or not.
+*
+* @param alarm Alarm number:
+*	 - #URTCLIB_ALARM_1
+*	 - #URTCLIB_ALARM_2
+*	 - #URTCLIB_ALARM_ANY
+*
+* @return bool true or false
+*/
+bool uRTCLib::alarmTriggered(const uint8_t alarm) {
+	if ((alarm == URTCLIB_ALARM_1 || alarm == URTCLIB_ALARM_ANY) && (bool) (_controlStatus & 0b00000001)) {
+		// _a1_triggered_flag = (bool) (_controlStatus & 0b00000001)
+		return true;
+	}
+	if ((alarm == URTCLIB_ALARM_2 || alarm == URTCLIB_ALARM_ANY) && (bool) (_controlStatus & 0b00000010)) {
+		// _a2_triggered_flag = (bool) (_controlStatus & 0b00000010)
+		return true;
+	}
+	return false;
+}
+
+
+/**
+ * \brief Reads alarm flags from RTC
+ *
+ * Single byte read of Status register (0x0Fh), no full refresh needed. Updates alarmTriggered() and lostPower() data.
+ *
+ * @return Triggered alarms, OR of #URTCLIB_ALARM_FLAG_1 and #URTCLIB_ALARM_FLAG_2. 0 on error or not supported (DS1307).
+ */
+uint8_t uRTCLib::pollAlarmFlags() {
+	uint8_t status;
+	if (_model == URTCLIB_MODEL_DS1307 || !_readRegisters(0x0F, &status, 1)) {
+		return 0;
+	}
+	_controlStatus = (_controlStatus & 0b01111100) | (status & 0b10000011); // OSF, A2F, A1F
+	return status & 0b00000011;
+}
+
+/**
+ * \brief Attaches an ISR to the falling edge of INT/SQW pin
+ *
+ * Pin is set as INPUT_PULLUP. Given ISR should just call alarmInterrupt(), i.e.:
+ * void rtcISR() { rtc.alarmInterrupt(); }
+ *
+ * @param pin MCU pin connected to INT/SQW
+ * @param isr Interrupt service routine
+ *
+ * @return False if pin has no interrupt or not supported (DS1307)
+ */
+bool uRTCLib::alarmInterruptBegin(const uint8_t pin, void (*isr)()) {
+	int interrupt = digitalPinToInterrupt(pin);
+	if (_model == URTCLIB_MODEL_DS1307 || interrupt < 0) {
+		return false;
+	}
+	pinMode(pin, INPUT_PULLUP);
+	_alarm_pending = false;
+	attachInterrupt(interrupt, isr, FALLING);
+	return true;
+}
+
+/**
+ * \brief Marks INT falling edge, to be called from ISR
+ *
+ * Only sets a flag, no I2C access. Work is deferred to alarmHandle().
+ */
+void uRTCLib::alarmInterrupt() {
+	_alarm_pending = true;
+}
+
+/**
+ * \brief Deferred alarm handler, call it from loop()
+ *
+ * If INT has been marked by alarmInterrupt() it reads Status register (0x0Fh) once, clears only fired
+ * alarm flags in one write and calls their callbacks. Returns immediately otherwise.
+ *
+ * @return Fired alarms, OR of #URTCLIB_ALARM_FLAG_1 and #URTCLIB_ALARM_FLAG_2
+ */
+uint8_t uRTCLib::alarmHandle() {
+	uint8_t status, fired;
+	if (!_alarm_pending) {
+		return 0;
+	}
+	_alarm_pending = false;
+	if (_model == URTCLIB_MODEL_DS1307 || !_readRegisters(0x0F, &status, 1)) {
+		return 0;
+	}
+	fired = status & 0b00000011;
+	if (fired) {
+		// Writing 1 to A1F/A2F leaves them unchanged, so an alarm firing right now is not lost
+		URTCLIB_WIRE.beginTransmission(_rtc_address);
+		URTCLIB_WIRE.write(0x0F);
+		URTCLIB_WIRE.write((status | 0b00000011) & ~fired);
+		URTCLIB_WIRE.endTransmission();
+		uRTCLIB_YIELD_POINT
+	}
+	_controlStatus = (_controlStatus & 0b01111100) | (status & 0b10000000);
+	if ((fired & URTCLIB_ALARM_FLAG_1) && _a1_callback != NULL) {
+		_a1_callback();
+	}
+	if ((fired & URTCLIB_ALARM_FLAG_2) && _a2_callback != NULL) {
+		_a2_callback();
+	}
+	return fired;
+}
+
+/**
+ * \brief Sets function to call from alarmHandle() when an alarm fires
+ *
+ * @param alarm Alarm number:
+ *	 - #URTCLIB_ALARM_1
+ *	 - #URTCLIB_ALARM_2
+ * @param callback Function to call, NULL to remove it
+ *
+ * @return false in case of wrong parameters
+ */
+bool uRTCLib::alarmCallbackSet(const uint8_t alarm, void (*callback)()) {
+	switch (alarm) {
+		case URTCLIB_ALARM_1: // Alarm 1
+			_a1_callback = callback;
+			return true;
+			break;
+
+		case URTCLIB_ALARM_2: // Alarm 2
+			_a2_callback = callback;
+			return true;
+			break;
+	} // Alarm type switch
+	return false;
+}
+
+#ifndef URTCLIB_NO_WAKE
+/**
+ * \brief Starts a periodic wake timer on Alarm 1
+ *
+ * Next wake is cached time (call refresh() before) plus period. Alarm 1 is programmed as #URTCLIB_ALARM_TYPE_1_FIXED_HMS,
+ * or #URTCLIB_ALARM_TYPE_1_FIXED_DHMS when it's 1 day or more ahead, and A1F is cleared on the same write.
+ *
+ * Useful when MCU is reset on each wake: call it on every boot. Schedule is kept in MCU RAM only, so then period must
+ * not exceed #URTCLIB_WAKE_MAX_STEP; a longer one is split in steps and each boot would start it again from now,
+ * never reaching its end.
+ *
+ * @param period Seconds between wakes
+ *
+ * @return false in case of not supported (DS1307), wrong parameters or error
+ */
+bool uRTCLib::wakeEvery(const uint32_t period) {
+	if (_model == URTCLIB_MODEL_DS1307 || period == 0) {
+		return false;
+	}
+	_wakePeriod = period;
+	_wakeNext = epoch() + period;
+	return _wakeArm(true);
+}
+
+/**
+ * \brief Programs next wake of periodic wake timer
+ *
+ * Call it after wake with refreshed time. If A1F is set next wake is computed from schedule, skipping missed ones,
+ * and Alarm 1 and A1F clearing are written in a single transaction. No write is done if A1F isn't set.
+ *
+ * @return True if a period has elapsed; false on intermediate steps of periods longer than #URTCLIB_WAKE_MAX_STEP, if A1F isn't set or on error
+ */
+bool uRTCLib::wakeRearm() {
+	return _wakeArm(false);
+}
+
+/**
+ * \brief Stops periodic wake timer and disables Alarm 1
+ *
+ * @return false in case of not supported (DS1307)
+ */
+bool uRTCLib::wakeStop() {
+	_wakePeriod = 0;
+	_wakeNext = 0;
+	return alarmDisable(URTCLIB_ALARM_1);
+}
+
+/**
+ * \brief Returns next scheduled wake of periodic wake timer
+ *
+ * @return UNIX timestamp, 0 if wake timer is not running
+ */
+uint32_t uRTCLib::wakeNext() {
+	return _wakeNext;
+}
+
+/**
+ * \brief Programs Alarm 1 for next wake and clears A1F in a single write of 0x07h to 0x0Fh
+ *
+ * Alarm 2, Control and Status registers are read first and written back unchanged, except A1IE/INTCN set,
+ * CONV not set and A1F cleared. OSF and A2F are written as 1, so they are not cleared even if set after the read.
+ *
+ * @param start True to program it without checking A1F, from wakeEvery()
+ *
+ * @return On start, false on error; otherwise true if a period has elapsed
+ */
+bool uRTCLib::_wakeArm(const bool start) {
+	uint8_t data[9], date[7], type; // 0x07h to 0x0Fh
+	uint32_t now = epoch(), target;
+	bool due = false;
+	if (_model == URTCLIB_MODEL_DS1307 || _wakePeriod == 0) {
+		return false;
+	}
+	if (!_readRegisters(0x0B, data + 4, 5)) {
+		return false;
+	}
+	if (!start) {
+		if (!(data[8] & 0b00000001)) { // A1F
+			return false;
+		}
+		if ((int32_t) (now - _wakeNext) >= 0) {
+			due = true;
+			_wakeNext += ((now - _wakeNext) / _wakePeriod + 1) * _wakePeriod;
+		}
+	}
+	target = _wakeNext - now > URTCLIB_WAKE_MAX_STEP ? now + URTCLIB_WAKE_MAX_STEP : _wakeNext;
+	type = target - now >= 86400UL ? URTCLIB_ALARM_TYPE_1_FIXED_DHMS : URTCLIB_ALARM_TYPE_1_FIXED_HMS;
+	_unixToDate(target, date);
+	data[0] = uRTCLIB_decToBcd(date[0]);
+	data[1] = uRTCLIB_decToBcd(date[1]);
+	data[2] = uRTCLIB_decToBcd(date[2]);
+	data[3] = uRTCLIB_decToBcd(date[4]) | ((type & 0b00001000) << 4); // A1M4 on HMS, date otherwise
+	data[7] = (data[7] | 0b00000101) & 0b11011111; // INTCN and A1IE bits, don't start a conversion
+	data[8] = (data[8] | 0b10000010) & 0b11111110; // Clear A1F only
+
+	if (!_writeRegisters(0x07, data, 9)) {
+		return false;
+	}
+	uRTCLIB_YIELD_POINT
+	_a1_mode = type;
+	_a1_second = date[0];
+	_a1_minute = date[1];
+	_a1_hour = date[2];
+	_a1_day_dow = date[4];
+	#ifndef URTCLIB_NO_SQWG
+	_sqwg_mode = URTCLIB_SQWG_OFF_1;
+	#endif
+	_controlStatus &= 0b11111110;
+	return start ? true : due;
+}
+
+/**
+ * \brief Starts a hardware watchdog on Alarm 2
  *
- * @param alarm Alarm number:
- *	 - #URTCLIB_ALARM_1
- *	 - #URTCLIB_ALARM_2
+ * Alarm 2 is set to match minutes (#URTCLIB_ALARM_TYPE_2_FIXED_M) timeout minutes ahead and its interrupt is enabled,
+ * so INT pin gets LOW if watchdogKick() isn't called in time. Connect INT to MCU reset through a capacitor, as on deepsleep
+ * example, because INT remains LOW until A2F is cleared. Call it on every boot; it clears A2F.
  *
- * @return Current stored day or dow. 0b11111111 means error.
+ * Actual timeout is between timeout - 1 and timeout minutes. Alarm 2 can't be used for anything else meanwhile.
+ *
+ * @param timeout Minutes, 2 to 59
+ *
+ * @return false in case of not supported (DS1307), wrong parameters or error
  */
-uint8_t uRTCLib::alarmDayDow(const uint8_t alarm) {
-	switch (_model) {
-		case URTCLIB_MODEL_DS1307:
-			return 0b11111111;
-			break;
-
-		// case URTCLIB_MODEL_DS3231: // Commented out because it's default mode
-		// case URTCLIB_MODEL_DS3232: // Commented out because it's default mode
-		default:
-			switch (alarm) {
-				case URTCLIB_ALARM_1: // Alarm 1
-					return _a1_day_dow;
-					break;
-
-				case URTCLIB_ALARM_2: // Alarm 2
-					return _a2_day_dow;
-					break;
-			} // Alarm type switch
-			break;
-	} // model switch
-	return 0b11111111;
+bool uRTCLib::watchdogBegin(const uint8_t timeout) {
+	uint8_t data[5], minute; // 0x0Bh to 0x0Fh
+	if (_model == URTCLIB_MODEL_DS1307 || timeout < 2 || timeout > 59) {
+		return false;
+	}
+	if (!_readRegisters(0x01, &minute, 1) || !_readRegisters(0x0E, data + 3, 2)) {
+		return false;
+	}
+	_watchdogFired = (bool) (data[4] & 0b00000010);
+	data[0] = uRTCLIB_decToBcd(((uRTCLIB_bcdToDec((minute & 0b01111111)) + timeout) % 60));
+	data[1] = 0b10000000; // A2M3, any hour
+	data[2] = 0b10000000; // A2M4, any day
+	data[3] = (data[3] | 0b00000110) & 0b11011111; // INTCN and A2IE bits, don't start a conversion
+	data[4] = (data[4] | 0b10000001) & 0b11111101; // Clear A2F only
+	if (!_writeRegisters(0x0B, data, 5)) {
+		return false;
+	}
+	uRTCLIB_YIELD_POINT
+	_watchdogTimeout = timeout;
+	_watchdogStamp = millis();
+	_a2_mode = URTCLIB_ALARM_TYPE_2_FIXED_M;
+	_a2_minute = uRTCLIB_bcdToDec(data[0]);
+	_a2_hour = 0;
+	_a2_day_dow = 0;
+	#ifndef URTCLIB_NO_SQWG
+	_sqwg_mode = URTCLIB_SQWG_OFF_1;
+	#endif
+	_controlStatus &= 0b11111101;
+	return true;
 }
 
-
 /**
-* \brief Checks if any alarm has been triggered
-*
-* NOTE: Alarm Flags A1F and A2F will be triggered whether or not Alarm Interrupt is Enabled A1IE and A2IE
-* When the RTC register values match alarm register settings, the corresponding Alarm Flag ‘A1F’ or ‘A2F’ bit is set to logic 1.
-* If using alarmTriggered function to check for alarm trigger, be sure to alarmMode function to see if alarm is enabled or not.
-*
-* @param alarm Alarm number:
-*	 - #URTCLIB_ALARM_1
-*	 - #URTCLIB_ALARM_2
-*	 - #URTCLIB_ALARM_ANY
-*
-* @return bool true or false
-*/
-bool uRTCLib::alarmTriggered(const uint8_t alarm) {
-	if ((alarm == URTCLIB_ALARM_1 || alarm == URTCLIB_ALARM_ANY) && (bool) (_controlStatus & 0b00000001)) {
-		// _a1_triggered_flag = (bool) (_controlStatus & 0b00000001)
-		return true;
+ * \brief Feeds watchdog
+ *
+ * Call it often from main loop. Only once each #URTCLIB_WATCHDOG_KICK_INTERVAL ms it accesses RTC: reads minutes
+ * register and writes Alarm 2 minutes register, 1 byte each. Other calls only check millis().
+ */
+void uRTCLib::watchdogKick() {
+	uint8_t minute;
+	if (_watchdogTimeout == 0 || millis() - _watchdogStamp < URTCLIB_WATCHDOG_KICK_INTERVAL) {
+		return;
 	}
-	if ((alarm == URTCLIB_ALARM_2 || alarm == URTCLIB_ALARM_ANY) && (bool) (_controlStatus & 0b00000010)) {
-		// _a2_triggered_flag = (bool) (_controlStatus & 0b00000010)
-		return true;
+	if (!_readRegisters(0x01, &minute, 1)) {
+		return; // Retry on next call
 	}
-	return false;
+	_watchdogStamp = millis();
+	minute = (uRTCLIB_bcdToDec((minute & 0b01111111)) + _watchdogTimeout) % 60;
+	URTCLIB_WIRE.beginTransmission(_rtc_address);
+	URTCLIB_WIRE.write(0x0B);
+	URTCLIB_WIRE.write(uRTCLIB_decToBcd(minute)); // A2M2 = 0, match minutes
+	URTCLIB_WIRE.endTransmission();
+	uRTCLIB_YIELD_POINT
+	_a2_minute = minute;
+}
+
+/**
+ * \brief Stops watchdog and disables Alarm 2
+ *
+ * @return false in case of not supported (DS1307)
+ */
+bool uRTCLib::watchdogStop() {
+	_watchdogTimeout = 0;
+	return alarmDisable(URTCLIB_ALARM_2);
+}
+
+/**
+ * \brief Checks if watchdog had fired before last watchdogBegin()
+ *
+ * @return True if A2F was set, so last reset was probably caused by watchdog
+ */
+bool uRTCLib::watchdogFired() {
+	return _watchdogFired;
 }
+#endif
+#endif
 
 
 
 
 
+#ifndef URTCLIB_NO_SQWG
 /************** SQuare Wave Generator ****************/
 
 /**
@@ -1346,7 +2767,7 @@ bool uRTCLib::alarmTriggered(const uint8_t alarm) {
  */
 bool uRTCLib::sqwgSetMode(const uint8_t mode) {
 	uint8_t status, processAnd = 0b00000000, processOr = 0b00000000;
-	uRTCLIB_YIELD
+	uRTCLIB_YIELD_POINT
 	switch (_model) {
 		case URTCLIB_MODEL_DS1307:
 			switch (mode) {
@@ -1383,22 +2804,17 @@ bool uRTCLib::sqwgSetMode(const uint8_t mode) {
 
 			if (processAnd || processOr) { // Any bit change?
 				URTCLIB_WIRE.beginTransmission(_rtc_address);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(0x07);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.endTransmission();
-				uRTCLIB_YIELD
+				uRTCLIB_YIELD_POINT
 				URTCLIB_WIRE.requestFrom(_rtc_address, 1);
 				status = URTCLIB_WIRE.read();
 				status = (status & processAnd) | processOr;
 				URTCLIB_WIRE.beginTransmission(_rtc_address);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(0x07);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(status);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.endTransmission();
-				uRTCLIB_YIELD
+				uRTCLIB_YIELD_POINT
 				_sqwg_mode = mode;
 				return true;
 			}
@@ -1437,32 +2853,29 @@ bool uRTCLib::sqwgSetMode(const uint8_t mode) {
 
 			if (processAnd || processOr) { // Any bit change?
 				URTCLIB_WIRE.beginTransmission(_rtc_address);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(0x0E);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.endTransmission();
-				uRTCLIB_YIELD
+				uRTCLIB_YIELD_POINT
 				URTCLIB_WIRE.requestFrom(_rtc_address, 1);
 				status = URTCLIB_WIRE.read();
 				status = (status & processAnd) | processOr;
 				URTCLIB_WIRE.beginTransmission(_rtc_address);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(0x0E);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.write(status);
-				uRTCLIB_YIELD
 				URTCLIB_WIRE.endTransmission();
-				uRTCLIB_YIELD
+				uRTCLIB_YIELD_POINT
 				_sqwg_mode = mode;
+				#ifndef URTCLIB_NO_ALARMS
 				if (mode == URTCLIB_SQWG_OFF_1 || mode == URTCLIB_SQWG_OFF_0) {
 					_a1_mode = URTCLIB_ALARM_TYPE_1_NONE;
 					_a2_mode = URTCLIB_ALARM_TYPE_2_NONE;
 				}
+				#endif
 				return true;
 			}
 			break;
 	} // model switch
-	uRTCLIB_YIELD
+	uRTCLIB_YIELD_POINT
 	return false;
 }
 
@@ -1482,8 +2895,10 @@ bool uRTCLib::sqwgSetMode(const uint8_t mode) {
 uint8_t uRTCLib::sqwgMode() {
 	return _sqwg_mode;
 }
+#endif
 
 
+#ifndef URTCLIB_NO_RAM
 /*** RAM functionality (Only DS1307. Addresses 08h to 3Fh so we offset 08h positions and limit to 38h as maximum address ***/
 
 
@@ -1495,29 +2910,14 @@ uint8_t uRTCLib::sqwgMode() {
  * @return content of that position. If any error it will return always 0xFF;
  */
 byte uRTCLib::ramRead(const uint8_t address) {
-	uint8_t offset = 0xff;
-	switch (_model) {
-		case URTCLIB_MODEL_DS1307:
-			if (address < 0x38) {
-				offset = 0x08;
-			}
-			break;
-
-		case URTCLIB_MODEL_DS3232:
-			if (address < 0xec) {
-				offset = 0x14;
-			}
-			break;
-	}
+	uint8_t offset = _ramOffset(address, 1);
 	if (offset != 0xff) {
 		URTCLIB_WIRE.beginTransmission(_rtc_address);
-		uRTCLIB_YIELD
 		URTCLIB_WIRE.write(address + offset);
-		uRTCLIB_YIELD
 		URTCLIB_WIRE.endTransmission();
-		uRTCLIB_YIELD
+		uRTCLIB_YIELD_POINT
 		URTCLIB_WIRE.requestFrom(_rtc_address, 1);
-		uRTCLIB_YIELD
+		uRTCLIB_YIELD_POINT
 		return URTCLIB_WIRE.read();
 	}
 	return 0xff;
@@ -1533,36 +2933,91 @@ byte uRTCLib::ramRead(const uint8_t address) {
  * @return true if correct
  */
 bool uRTCLib::ramWrite(const uint8_t address, byte data) {
-	uint8_t offset = 0xff;
+	uint8_t offset = _ramOffset(address, 1);
+	if (offset != 0xff) {
+		URTCLIB_WIRE.beginTransmission(_rtc_address);
+		URTCLIB_WIRE.write(address + offset);
+		URTCLIB_WIRE.write(data);
+		URTCLIB_WIRE.endTransmission();
+		uRTCLIB_YIELD_POINT
+		return true;
+	}
+	return false;
+}
+
+
+/**
+ * \brief Reads a block from RTC RAM
+ *
+ * Reads in #URTCLIB_WIRE_BURST bytes transactions
+ *
+ * @param address RAM Address of first byte
+ * @param data Buffer to store content
+ * @param length Number of bytes to read
+ *
+ * @return true if correct
+ */
+bool uRTCLib::ramReadBlock(const uint8_t address, byte *data, const uint8_t length) {
+	uint8_t offset = _ramOffset(address, length);
+	if (offset == 0xff) {
+		return false;
+	}
+	return _readRegisters(address + offset, data, length);
+}
+
+
+/**
+ * \brief Writes a block to RTC RAM
+ *
+ * Writes in #URTCLIB_WIRE_BURST bytes transactions, register address included
+ *
+ * @param address RAM Address of first byte
+ * @param data Content to write
+ * @param length Number of bytes to write
+ *
+ * @return true if correct
+ */
+bool uRTCLib::ramWriteBlock(const uint8_t address, const byte *data, const uint8_t length) {
+	uint8_t offset = _ramOffset(address, length);
+	if (offset == 0xff) {
+		return false;
+	}
+	return _writeRegisters(address + offset, data, length);
+}
+
+
+/**
+ * \brief Gets RAM register offset for a RAM block
+ *
+ * DS1307: Addresses 08h to 3Fh so we offset 08h positions and limit to 38h as maximum address
+ * DS3232: Addresses 14h to FFh so we offset 14h positions and limit to EBh as maximum address
+ *
+ * @param address RAM Address of first byte
+ * @param length Block length
+ *
+ * @return Offset to add to RAM address, 0xFF if not supported or out of range
+ */
+uint8_t uRTCLib::_ramOffset(const uint8_t address, const uint8_t length) {
 	switch (_model) {
 		case URTCLIB_MODEL_DS1307:
-			if (address < 0x38) {
-				offset = 0x08;
+			if (length && (uint16_t) address + length <= 0x38) {
+				return 0x08;
 			}
 			break;
 
 		case URTCLIB_MODEL_DS3232:
-			if (address < 0xec) {
-				offset = 0x14;
+			if (length && (uint16_t) address + length <= 0xec) {
+				return 0x14;
 			}
 			break;
 	}
-	if (offset != 0xff) {
-		URTCLIB_WIRE.beginTransmission(_rtc_address);
-		uRTCLIB_YIELD
-		URTCLIB_WIRE.write(address + offset);
-		uRTCLIB_YIELD
-		URTCLIB_WIRE.write(data);
-		uRTCLIB_YIELD
-		URTCLIB_WIRE.endTransmission();
-		uRTCLIB_YIELD
-		return true;
-	}
-	return false;
+	return 0xff;
 }
+#endif
 
 
 
+#ifndef URTCLIB_NO_AGING
 /**
  * \brief Reads actual aging value on the RTC
  *
@@ -1584,49 +3039,109 @@ bool uRTCLib::agingSet(int8_t val) {
 	switch (_model) {
 		case URTCLIB_MODEL_DS3231:
 		case URTCLIB_MODEL_DS3232:
+			_aging = val;
 			if (val < 0) {
 				val++;
 			}
 			URTCLIB_WIRE.beginTransmission(_rtc_address);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(0x10);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(val);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.endTransmission();
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 
 			ret = true;
 
 			// Read status register 0x0E
 			URTCLIB_WIRE.beginTransmission(_rtc_address);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(0x0E);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.endTransmission();
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 			URTCLIB_WIRE.requestFrom(_rtc_address, 1);
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 			byte status = URTCLIB_WIRE.read();
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 
 			// Enable CONV bit on status register 0x0E to apply changes inmediately
 			status |= 0b00100000;
 			URTCLIB_WIRE.beginTransmission(_rtc_address);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(0x0E);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(status);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.endTransmission();
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 
 	}
 	return ret;
 }
+#endif
+
+
+
+#ifndef URTCLIB_NO_AGING_PROFILE
+/**
+ * \brief Sets a temperature indexed aging profile
+ *
+ * After each temperature read (refresh() or tempRead()) aging is interpolated from the table and written
+ * with agingSet() only when resulting value changes. Temperatures out of table range use first or last point.
+ *
+ * Table is not copied, it must stay valid. Only DS3231 and DS3232.
+ *
+ * @param table Profile points, sorted by ascending temperature. NULL disables profile.
+ * @param points Number of points
+ */
+void uRTCLib::agingProfileSet(const uRTCLibAgingPoint *table, const uint8_t points) {
+	_agingProfile = points ? table : NULL;
+	_agingProfilePoints = points;
+	_agingProfileTemp = URTCLIB_TEMP_ERROR;
+	_agingProfileTarget = URTCLIB_TEMP_ERROR;
+}
+
+/**
+ * \brief Interpolates aging value for a temperature from active profile
+ *
+ * @param temp Temperature, degrees * 100
+ *
+ * @return Aging value, 0 if there's no profile
+ */
+int8_t uRTCLib::agingProfileGet(const int16_t temp) {
+	uint8_t i;
+	int16_t span;
+	if (_agingProfile == NULL) {
+		return 0;
+	}
+	if (temp <= _agingProfile[0].temp) {
+		return _agingProfile[0].aging;
+	}
+	for (i = 1; i < _agingProfilePoints; i++) {
+		if (temp < _agingProfile[i].temp) {
+			span = _agingProfile[i].temp - _agingProfile[i - 1].temp;
+			return _agingProfile[i - 1].aging + ((int32_t) (_agingProfile[i].aging - _agingProfile[i - 1].aging) * (temp - _agingProfile[i - 1].temp) * 2 + span) / (span * 2);
+		}
+	}
+	return _agingProfile[_agingProfilePoints - 1].aging;
+}
+
+/**
+ * \brief Applies aging profile to last read temperature
+ *
+ * Just a table lookup when temperature changed; I2C write only when aging changes.
+ */
+void uRTCLib::_agingProfileApply() {
+	int8_t target;
+	if (_agingProfile == NULL || _temp == _agingProfileTemp) {
+		return;
+	}
+	_agingProfileTemp = _temp;
+	target = agingProfileGet(_temp);
+	if (target != _agingProfileTarget) {
+		_agingProfileTarget = target;
+		agingSet(target);
+	}
+}
+#endif
 
 
 
+#ifndef URTCLIB_NO_32K
 /**
  * \brief Enables 32K pin output
  *
@@ -1638,30 +3153,31 @@ bool uRTCLib::enable32KOut() {
 	_controlStatus |= 0b00001000;
 	switch (_model) {
 		case URTCLIB_MODEL_DS1307: // As DS1307 doesn't have this pin, map it to SqWG at same frequency
+			#ifdef URTCLIB_NO_SQWG
+			return false;
+			#else
 			return sqwgSetMode(URTCLIB_SQWG_32768H);
+			#endif
 			break;
 
 		// case URTCLIB_MODEL_DS3231: // Commented out because it's default mode
 		// case URTCLIB_MODEL_DS3232: // Commented out because it's default mode
 		default:
 			uint8_t status;
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 			URTCLIB_WIRE.beginTransmission(_rtc_address);
 			URTCLIB_WIRE.write(0X0F);
 			URTCLIB_WIRE.endTransmission();
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 			URTCLIB_WIRE.requestFrom(_rtc_address, 1);
 			status = URTCLIB_WIRE.read();
 			status |= 0b00001000;
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 			URTCLIB_WIRE.beginTransmission(_rtc_address);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(0X0F);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(status);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.endTransmission();
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 			return true;
 			break;
 	}
@@ -1677,30 +3193,31 @@ bool uRTCLib::disable32KOut() {
 	_controlStatus &= 0b11110111;
 	switch (_model) {
 		case URTCLIB_MODEL_DS1307: // As DS1307 doesn't have this pin, map it to SqWG at same frequency
+			#ifdef URTCLIB_NO_SQWG
+			return false;
+			#else
 			return sqwgSetMode(URTCLIB_SQWG_OFF_0);
+			#endif
 			break;
 
 		// case URTCLIB_MODEL_DS3231: // Commented out because it's default mode
 		// case URTCLIB_MODEL_DS3232: // Commented out because it's default mode
 		default:
 			uint8_t status;
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 			URTCLIB_WIRE.beginTransmission(_rtc_address);
 			URTCLIB_WIRE.write(0X0F);
 			URTCLIB_WIRE.endTransmission();
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 			URTCLIB_WIRE.requestFrom(_rtc_address, 1);
 			status = URTCLIB_WIRE.read();
 			status &= 0b11110111;
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 			URTCLIB_WIRE.beginTransmission(_rtc_address);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(0X0F);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.write(status);
-			uRTCLIB_YIELD
 			URTCLIB_WIRE.endTransmission();
-			uRTCLIB_YIELD
+			uRTCLIB_YIELD_POINT
 			return true;
 			break;
 	}
@@ -1715,6 +3232,213 @@ bool uRTCLib::disable32KOut() {
 bool uRTCLib::status32KOut() {
 	return (bool) (_controlStatus & 0b00001000);
 }
+#endif
 
 
 /*** EEPROM functionality has been moved to separate library: https://github.com/Naguissa/uEEPROMLib ***/
+
+
+
+/************** Registers snapshot ****************/
+
+/**
+ * \brief Reads whole RTC register space, including RAM
+ *
+ * Reads up to #URTCLIB_SNAPSHOT_SIZE registers, in as few transactions as #URTCLIB_WIRE_BUFFER allows.
+ *
+ * @param snapshot Where to store registers
+ *
+ * @return False on error
+ */
+bool uRTCLib::dumpRegisters(uRTCLibSnapshot &snapshot) {
+	uint16_t length = _registerSpace();
+	if (length > URTCLIB_SNAPSHOT_SIZE) {
+		length = URTCLIB_SNAPSHOT_SIZE;
+	}
+	if (!_readRegisters(0, snapshot.reg, length)) {
+		return false;
+	}
+	snapshot.model = _model;
+	snapshot.length = length;
+	return true;
+}
+
+/**
+ * \brief Writes a snapshot back, only registers that differ from RTC
+ *
+ * RTC is read again in #URTCLIB_WIRE_BURST - 1 bytes blocks and each run of different registers is written in a single transaction.
+ * On DS3231/DS3232 temperature registers are skipped, CONV is never set and Status register flags (OSF, A1F, A2F) are
+ * kept, even when set during restore; only its configuration bits are restored. Cached data is refreshed at the end.
+ *
+ * Useful to clone a configured RTC to a replacement of same model.
+ *
+ * @param snapshot Registers to restore, from dumpRegisters()
+ * @param time Restore also time registers (0x00h to 0x06h)
+ *
+ * @return Number of registers written, -1 on error or different model
+ */
+int16_t uRTCLib::restoreRegisters(const uRTCLibSnapshot &snapshot, const bool time) {
+	uint8_t current[URTCLIB_WIRE_BURST - 1], value[URTCLIB_WIRE_BURST - 1], chunk, i, start;
+	uint16_t address = time ? 0x00 : 0x07, length = snapshot.length;
+	int16_t written = 0;
+	if (snapshot.model != _model) {
+		return -1;
+	}
+	if (length > _registerSpace()) {
+		length = _registerSpace();
+	}
+	while (address < length) {
+		// Blocks fit a write transaction, so any run is written at once
+		chunk = length - address > URTCLIB_WIRE_BURST - 1 ? URTCLIB_WIRE_BURST - 1 : length - address;
+		if (!_readRegisters(address, current, chunk)) {
+			return -1;
+		}
+		i = 0;
+		while (i < chunk) {
+			if (!_restoreByte(address + i, snapshot.reg[address + i], current[i], &value[i])) {
+				i++;
+				continue;
+			}
+			// Run of registers to write
+			start = i;
+			while (++i < chunk && _restoreByte(address + i, snapshot.reg[address + i], current[i], &value[i])) { }
+			if (!_writeRegisters(address + start, value + start, i - start)) {
+				return -1;
+			}
+			written += i - start;
+		}
+		address += chunk;
+	}
+	refresh();
+	return written;
+}
+
+/**
+ * \brief Finds next different register between 2 snapshots
+ *
+ * Call it again with returned address + 1 to get the next one.
+ *
+ * @param a First snapshot
+ * @param b Second snapshot
+ * @param from First register to compare
+ *
+ * @return Register address, -1 if there are no more differences
+ */
+int16_t uRTCLib::diffRegisters(const uRTCLibSnapshot &a, const uRTCLibSnapshot &b, const uint16_t from) {
+	uint16_t address, length = a.length < b.length ? a.length : b.length;
+	for (address = from; address < length; address++) {
+		if (a.reg[address] != b.reg[address]) {
+			return address;
+		}
+	}
+	return -1;
+}
+
+/**
+ * \brief Returns register space size of current model
+ *
+ * @return Number of registers, from 0x00h
+ */
+uint16_t uRTCLib::_registerSpace() {
+	switch (_model) {
+		case URTCLIB_MODEL_DS1307:
+			return 0x40;
+
+		case URTCLIB_MODEL_DS3232:
+			return 0x100;
+	}
+	return 0x13; // DS3231
+}
+
+/**
+ * \brief Computes value to restore on a register
+ *
+ * @param address Register address
+ * @param wanted Value on snapshot
+ * @param current Value on RTC
+ * @param value Value to write
+ *
+ * @return True if register has to be written
+ */
+bool uRTCLib::_restoreByte(const uint8_t address, const uint8_t wanted, const uint8_t current, uint8_t *value) {
+	*value = wanted;
+	if (_model != URTCLIB_MODEL_DS1307) {
+		switch (address) {
+			case 0x0E: // Control, don't start a conversion
+				*value = wanted & 0b11011111;
+				break;
+
+			case 0x0F: // Status, configuration bits only; writing 1 leaves OSF, A2F and A1F unchanged, even if set after the read
+				*value = (wanted & 0b01111000) | 0b10000011;
+				return (wanted ^ current) & 0b01111000;
+
+			case 0x11: // Temperature, read only
+			case 0x12:
+			case 0x13: // Reserved (DS3232)
+				return false;
+		}
+	}
+	return *value != current;
+}
+
+
+/************** Yield policy ****************/
+
+/**
+ * \brief Sets yield policy of this instance
+ *
+ * Yield points are placed between I2C transactions, never inside them nor inside setPrecise() transfer time measurement. No effect if #URTCLIB_YIELD_POLICY is #URTCLIB_YIELD_NONE.
+ *
+ * @param policy Yield policy:
+ *	 - #URTCLIB_YIELD_NONE
+ *	 - #URTCLIB_YIELD_TRANSACTION
+ *	 - #URTCLIB_YIELD_BUDGET
+ * @param budget Microseconds between yields for #URTCLIB_YIELD_BUDGET
+ */
+void uRTCLib::yieldPolicy(const uint8_t policy, const uint16_t budget) {
+	#if URTCLIB_YIELD_POLICY != URTCLIB_YIELD_NONE
+	_yield_policy = policy;
+	_yield_budget = budget;
+	_yield_stamp = micros();
+	#else
+	(void) policy;
+	(void) budget;
+	#endif
+}
+
+/**
+ * \brief Returns yield policy of this instance
+ *
+ * @return Yield policy, #URTCLIB_YIELD_NONE if yield code is not compiled
+ */
+uint8_t uRTCLib::yieldPolicy() {
+	#if URTCLIB_YIELD_POLICY != URTCLIB_YIELD_NONE
+	return _yield_policy;
+	#else
+	return URTCLIB_YIELD_NONE;
+	#endif
+}
+
+#if URTCLIB_YIELD_POLICY != URTCLIB_YIELD_NONE
+/**
+ * \brief Yield point, applies instance yield policy
+ */
+void uRTCLib::_yield() {
+	switch (_yield_policy) {
+		case URTCLIB_YIELD_TRANSACTION:
+			yield();
+			break;
+
+		case URTCLIB_YIELD_BUDGET:
+			if (micros() - _yield_stamp >= _yield_budget) {
+				yield();
+				_yield_stamp = micros();
+			}
+			break;
+
+		// case URTCLIB_YIELD_NONE:
+		default:
+			break;
+	}
+}
+#endif
@@ -40,7 +40,11 @@
 	#define URTCLIB
 	#include "Arduino.h"
 	#ifndef URTCLIB_WIRE
-		#if defined(ARDUINO_attiny) || defined(ARDUINO_AVR_ATTINYX4) || defined(ARDUINO_AVR_ATTINYX5) || defined(ARDUINO_AVR_ATTINYX7) || defined(ARDUINO_AVR_ATTINYX8) || defined(ARDUINO_AVR_ATTINYX61) || defined(ARDUINO_AVR_ATTINY43) || defined(ARDUINO_AVR_ATTINY828) || defined(ARDUINO_AVR_ATTINY1634) || defined(ARDUINO_AVR_ATTINYX313)
+		#if defined(URTCLIB_SOFTWIRE_SDA) && defined(URTCLIB_SOFTWIRE_SCL)
+			#include "uRTCLibSoftWire.h"                 // Software I2C on any pins, see uRTCLibSoftWire
+			extern uRTCLibSoftWire<URTCLIB_SOFTWIRE_SDA, URTCLIB_SOFTWIRE_SCL> uRTCLibSoftWireBus;
+			#define URTCLIB_WIRE uRTCLibSoftWireBus
+		#elif defined(ARDUINO_attiny) || defined(ARDUINO_AVR_ATTINYX4) || defined(ARDUINO_AVR_ATTINYX5) || defined(ARDUINO_AVR_ATTINYX7) || defined(ARDUINO_AVR_ATTINYX8) || defined(ARDUINO_AVR_ATTINYX61) || defined(ARDUINO_AVR_ATTINY43) || defined(ARDUINO_AVR_ATTINY828) || defined(ARDUINO_AVR_ATTINY1634) || defined(ARDUINO_AVR_ATTINYX313)
 			#include <TinyWireM.h>                  // I2C Master lib for ATTinys which use USI
 			#define URTCLIB_WIRE TinyWireM
 		#else
@@ -49,6 +53,154 @@
 		#endif
 	#endif
 
+
+	/************	I2C TRANSFER ***********/
+	/**
+	 * \brief Bytes that fit on a single I2C transaction of active transport
+	 *
+	 * Taken from transport buffer: #URTCLIB_SOFTWIRE_BUFFER (uRTCLibSoftWire), TinyWireM USI_BUF_SIZE (minus slave address byte),
+	 * I2C_BUFFER_LENGTH (ESP32, ESP8266), WIRE_BUFFER_SIZE (RP2040), BUFFER_LENGTH (AVR, SAM, SAMD, STM32 and most cores)
+	 * or 32 if none is found.
+	 *
+	 * Define it to override, i.e. with a custom URTCLIB_WIRE. All reads and writes are split to fit it.
+	 */
+	#ifndef URTCLIB_WIRE_BUFFER
+		#if defined(URTCLIB_SOFTWIRE_SDA) && defined(URTCLIB_SOFTWIRE_SCL)
+			#define URTCLIB_WIRE_BUFFER URTCLIB_SOFTWIRE_BUFFER
+		#elif defined(USI_BUF_SIZE)
+			#define URTCLIB_WIRE_BUFFER (USI_BUF_SIZE - 1)
+		#elif defined(I2C_BUFFER_LENGTH)
+			#define URTCLIB_WIRE_BUFFER I2C_BUFFER_LENGTH
+		#elif defined(WIRE_BUFFER_SIZE)
+			#define URTCLIB_WIRE_BUFFER WIRE_BUFFER_SIZE
+		#elif defined(BUFFER_LENGTH)
+			#define URTCLIB_WIRE_BUFFER BUFFER_LENGTH
+		#else
+			#define URTCLIB_WIRE_BUFFER 32
+		#endif
+	#endif
+
+	/**
+	 * \brief Maximum bytes per I2C transaction, #URTCLIB_WIRE_BUFFER limited to 8 bit transfer counts
+	 */
+	#define URTCLIB_WIRE_BURST (URTCLIB_WIRE_BUFFER > 255 ? 255 : URTCLIB_WIRE_BUFFER)
+
+	/**
+	 * \brief Checks requestFrom() result
+	 *
+	 * TinyWireM returns 0 on success instead of number of bytes received
+	 */
+	#ifndef URTCLIB_WIRE_RECEIVED
+		#ifdef USI_BUF_SIZE
+			#define URTCLIB_WIRE_RECEIVED(received, requested) ((received) == 0)
+		#else
+			#define URTCLIB_WIRE_RECEIVED(received, requested) ((received) >= (requested))
+		#endif
+	#endif
+
+	/**
+	 * \brief Sets bus clock, see uRTCLib::busClock()
+	 *
+	 * TinyWireM has no clock selection, so there it does nothing
+	 */
+	#ifndef URTCLIB_WIRE_CLOCK
+		#ifdef USI_BUF_SIZE
+			#define URTCLIB_WIRE_CLOCK(hz)
+		#else
+			#define URTCLIB_WIRE_CLOCK(hz) URTCLIB_WIRE.setClock(hz)
+		#endif
+	#endif
+
+	/**
+	 * \brief DS1307 maximum I2C clock, standard mode
+	 */
+	#ifndef URTCLIB_CLOCK_DS1307
+		#define URTCLIB_CLOCK_DS1307 100000UL
+	#endif
+
+	/**
+	 * \brief DS3231 and DS3232 maximum I2C clock, fast mode. Lower it for long or heavily loaded buses.
+	 */
+	#ifndef URTCLIB_CLOCK_DS323X
+		#define URTCLIB_CLOCK_DS323X 400000UL
+	#endif
+
+
+	/************	FEATURE SELECTION ***********/
+	// Define any of these to remove a feature: its methods, its code and its cached data.
+	// uRTCLib.cpp is compiled on its own, so they must be global build flags (i.e. -DURTCLIB_NO_ALARMS on
+	// build_flags or compiler.cpp.extra_flags), a #define on the sketch doesn't reach the library.
+	// See extras/size_report.sh to check footprint of each one.
+	//
+	// URTCLIB_NO_ALARMS       - Alarms and alarm interrupt
+	// URTCLIB_NO_TEMP         - Temperature
+	// URTCLIB_NO_TEMP_CONV    - On-demand temperature conversion only (tempConvert(), tempReady(), tempTimedOut())
+	// URTCLIB_NO_SQWG         - SQuare Wave Generator, also uRTCLibOscCal
+	// URTCLIB_NO_RAM          - RAM, also uRTCLibJournal; monotonic offset is only kept on MCU RAM
+	// URTCLIB_NO_AGING        - Aging, also uRTCLibAgingCal
+	// URTCLIB_NO_32K          - 32K pin output
+	// URTCLIB_NO_12H          - 12 hour mode; RTC is expected to be in 24 hour mode, as set() leaves it
+	// URTCLIB_NO_DETECT       - Model detection (detect(), detectMicros())
+	// URTCLIB_NO_BUS_CLOCK    - Bus clock switching (busClock()); transfers run at whatever clock the bus has
+	// URTCLIB_NO_POWER_PROFILE - Power profile (powerProfileSet(), powerProfile())
+	//
+	// These features are left out unless their flag is defined, also globally, as they add cached data to every instance:
+	//
+	// URTCLIB_WITH_CHANGES     - Change mask and change callbacks (changes(), onChange()), 13 bytes on AVR
+	// URTCLIB_WITH_PRECISE_SET - setPrecise(), setPhaseError() and setLatency(), 8 bytes
+	// URTCLIB_WITH_MONOTONIC   - Monotonic seconds counter (monotonicBegin(), monotonic(), monotonicOffset()), 9 bytes;
+	//                            set() and friends read RTC time before writing to keep it
+	// URTCLIB_WITH_WAKE        - Wake timer and watchdog on alarms (wakeEvery(), watchdogBegin()...), 14 bytes
+	//
+	// Default instance size on AVR is 51 bytes, 95 with all of them.
+	//
+	// URTCLIB_PACKED          - Not a feature: stores cached datetime, alarms, modes and flags as bit-fields, sized to hold any
+	//                           decoded register value. Same accessors and results (see extras/test/test_layout.cpp),
+	//                           slightly bigger and slower code. Instance size on AVR is 46 bytes instead of 51 by default,
+	//                           88 instead of 95 with all URTCLIB_WITH_* features, 10 instead of 11 with all features removed.
+
+	#if defined(URTCLIB_NO_AGING) || defined(URTCLIB_NO_TEMP)
+		/**
+		 * \brief Aging profile needs both aging and temperature
+		 */
+		#define URTCLIB_NO_AGING_PROFILE
+	#endif
+
+	#if (!defined(URTCLIB_WITH_WAKE) || defined(URTCLIB_NO_ALARMS)) && !defined(URTCLIB_NO_WAKE)
+		/**
+		 * \brief Wake timer and watchdog are opt-in and run on alarms
+		 */
+		#define URTCLIB_NO_WAKE
+	#endif
+
+	#if !defined(URTCLIB_WITH_CHANGES) && !defined(URTCLIB_NO_CHANGES)
+		/**
+		 * \brief Change tracking is opt-in
+		 */
+		#define URTCLIB_NO_CHANGES
+	#endif
+
+	#if !defined(URTCLIB_WITH_PRECISE_SET) && !defined(URTCLIB_NO_PRECISE_SET)
+		/**
+		 * \brief Precise set is opt-in
+		 */
+		#define URTCLIB_NO_PRECISE_SET
+	#endif
+
+	#if !defined(URTCLIB_WITH_MONOTONIC) && !defined(URTCLIB_NO_MONOTONIC)
+		/**
+		 * \brief Monotonic counter is opt-in
+		 */
+		#define URTCLIB_NO_MONOTONIC
+	#endif
+
+	#if defined(URTCLIB_NO_TEMP) && !defined(URTCLIB_NO_TEMP_CONV)
+		/**
+		 * \brief On-demand conversion is part of temperature
+		 */
+		#define URTCLIB_NO_TEMP_CONV
+	#endif
+
 	/**
 	 * \brief Default RTC I2C address
 	 *
@@ -57,6 +209,10 @@
 	#define URTCLIB_ADDRESS 0x68
 
 	/************	MODELS ***********/
+	/**
+	 * \brief Model definition, unknown or not detected device
+	 */
+	#define URTCLIB_MODEL_UNKNOWN 0
 	/**
 	 * \brief Model definition, DS1307
 	 */
@@ -209,6 +365,38 @@
 	 */
 	#define URTCLIB_ALARM_ANY 0b01010101
 
+	/**
+	 * \brief Alarm 1 flag (A1F) bit on pollAlarmFlags() and alarmHandle() return values
+	 */
+	#define URTCLIB_ALARM_FLAG_1 0b00000001
+
+	/**
+	 * \brief Alarm 2 flag (A2F) bit on pollAlarmFlags() and alarmHandle() return values
+	 */
+	#define URTCLIB_ALARM_FLAG_2 0b00000010
+
+
+	/************	WAKE TIMER: ***********/
+	/**
+	 * \brief Maximum distance, in seconds, Alarm 1 is programmed ahead on wake timer
+	 *
+	 * Alarm 1 matches day of month, so longer periods are split in steps of up to 28 days
+	 */
+	#ifndef URTCLIB_WAKE_MAX_STEP
+		#define URTCLIB_WAKE_MAX_STEP 2419200UL
+	#endif
+
+
+	/************	WATCHDOG: ***********/
+	/**
+	 * \brief Minimum milliseconds between watchdogKick() RTC accesses
+	 *
+	 * Must be well below 1 minute, as shortest timeout is 1 to 2 minutes
+	 */
+	#ifndef URTCLIB_WATCHDOG_KICK_INTERVAL
+		#define URTCLIB_WATCHDOG_KICK_INTERVAL 30000UL
+	#endif
+
 
 	/************	SQWG SELECTION: ***********/
 
@@ -254,6 +442,140 @@
 	#define URTCLIB_SQWG_32768H 0b00000011
 
 
+	/************	POWER PROFILE: ***********/
+	//Note: Not valid for DS1307! CRATE and BB32kHz are DS3232 only, DS3231 uses BBSQW only.
+
+	/**
+	 * \brief Power profile - Temperature conversion every 64 seconds (DS3232)
+	 *
+	 * Power profile structure:
+	 *
+	 * bit 0 - CRATE0, 0x0Fh bit 4
+	 * bit 1 - CRATE1, 0x0Fh bit 5
+	 * bit 2 - BB32kHz, 0x0Fh bit 6, 32kHz output enabled on battery
+	 * bit 3 - BBSQW, 0x0Eh bit 6, SQW/INT output enabled on battery
+	 * bit 4-7 - Unused, always 0
+	 */
+	#define URTCLIB_POWER_CRATE_64S 0b00000000
+
+	/**
+	 * \brief Power profile - Temperature conversion every 128 seconds (DS3232)
+	 */
+	#define URTCLIB_POWER_CRATE_128S 0b00000001
+
+	/**
+	 * \brief Power profile - Temperature conversion every 256 seconds (DS3232)
+	 */
+	#define URTCLIB_POWER_CRATE_256S 0b00000010
+
+	/**
+	 * \brief Power profile - Temperature conversion every 512 seconds (DS3232)
+	 */
+	#define URTCLIB_POWER_CRATE_512S 0b00000011
+
+	/**
+	 * \brief Power profile - 32kHz output kept running on battery (DS3232)
+	 */
+	#define URTCLIB_POWER_BB32KHZ 0b00000100
+
+	/**
+	 * \brief Power profile - SQW/INT output kept running on battery
+	 */
+	#define URTCLIB_POWER_BBSQW 0b00001000
+
+	/**
+	 * \brief Power profile - Maximum accuracy: conversion every 64s, all outputs alive on battery
+	 */
+	#define URTCLIB_POWER_MAX_ACCURACY (URTCLIB_POWER_CRATE_64S | URTCLIB_POWER_BB32KHZ | URTCLIB_POWER_BBSQW)
+
+	/**
+	 * \brief Power profile - Balanced: conversion every 256s, only SQW/INT (alarms) alive on battery
+	 */
+	#define URTCLIB_POWER_BALANCED (URTCLIB_POWER_CRATE_256S | URTCLIB_POWER_BBSQW)
+
+	/**
+	 * \brief Power profile - Minimum battery drain: conversion every 512s, all outputs off on battery
+	 */
+	#define URTCLIB_POWER_MIN_DRAIN URTCLIB_POWER_CRATE_512S
+
+
+	/************	CHANGE NOTIFICATION: ***********/
+
+	/**
+	 * \brief Change mask - Second changed on last refresh
+	 */
+	#define URTCLIB_CHANGE_SECOND 0b00000001
+
+	/**
+	 * \brief Change mask - Minute changed on last refresh
+	 */
+	#define URTCLIB_CHANGE_MINUTE 0b00000010
+
+	/**
+	 * \brief Change mask - Hour changed on last refresh
+	 */
+	#define URTCLIB_CHANGE_HOUR 0b00000100
+
+	/**
+	 * \brief Change mask - Day changed on last refresh
+	 */
+	#define URTCLIB_CHANGE_DAY 0b00001000
+
+	/**
+	 * \brief Change mask - Month (or year) changed on last refresh
+	 */
+	#define URTCLIB_CHANGE_MONTH 0b00010000
+
+	/**
+	 * \brief Change mask - An alarm flag has been set since last refresh
+	 */
+	#define URTCLIB_CHANGE_ALARM 0b00100000
+
+	/**
+	 * \brief Change mask - Lost power flag has been set since last refresh
+	 */
+	#define URTCLIB_CHANGE_LOST_POWER 0b01000000
+
+	/**
+	 * \brief Change mask - Temperature changed on last refresh
+	 */
+	#define URTCLIB_CHANGE_TEMP 0b10000000
+
+	/**
+	 * \brief Change mask - Any change
+	 */
+	#define URTCLIB_CHANGE_ANY 0b11111111
+
+	/**
+	 * \brief Maximum number of change callbacks
+	 */
+	#ifndef URTCLIB_CHANGE_CALLBACKS
+		#define URTCLIB_CHANGE_CALLBACKS 4
+	#endif
+
+
+	/************	TEXT FORMAT ***********/
+	/**
+	 * \brief Text format - ISO 8601 extended: 2024-01-31T23:59:50
+	 */
+	#define URTCLIB_FORMAT_ISO8601 0
+
+	/**
+	 * \brief Text format - ISO 8601 basic, for compact logs: 20240131T235950
+	 */
+	#define URTCLIB_FORMAT_COMPACT 1
+
+	/**
+	 * \brief Text format - 12 hour: 2024-01-31 11:59:50 PM
+	 */
+	#define URTCLIB_FORMAT_12H 2
+
+	/**
+	 * \brief Buffer size needed by format(), including trailing NUL
+	 */
+	#define URTCLIB_FORMAT_LENGTH 23
+
+
 	/************	TEMPERATURE ***********/
 	/**
 	 * \brief Temperarure read error indicator return value
@@ -262,6 +584,63 @@
 	 */
 	#define URTCLIB_TEMP_ERROR 32767
 
+	/**
+	 * \brief Maximum time, in milliseconds, tempReady() waits for an on-demand temperature conversion
+	 *
+	 * Datasheet conversion time is 200ms max; after this conversion is given up, see uRTCLib::tempTimedOut()
+	 */
+	#ifndef URTCLIB_TEMP_CONV_TIMEOUT
+		#define URTCLIB_TEMP_CONV_TIMEOUT 250
+	#endif
+
+
+	/************	PRECISE SET ***********/
+	/**
+	 * \brief Phase measurement error indicator return value
+	 *
+	 * Returned by setPhaseError() when no SQW edge is seen
+	 */
+	#define URTCLIB_PHASE_ERROR 2147483647L
+
+	/**
+	 * \brief Minimum time, in microseconds, kept between setPrecise() preparation and the write
+	 *
+	 * If the next second boundary is closer than this plus the measured transfer time the following one is used
+	 */
+	#ifndef URTCLIB_PRECISE_SET_MARGIN
+		#define URTCLIB_PRECISE_SET_MARGIN 2000
+	#endif
+
+
+	/************	MONOTONIC ***********/
+	/**
+	 * \brief RAM address where monotonic offset is stored (DS1307 and DS3232)
+	 *
+	 * Uses 5 bytes. Default RAM layout, checked at compile time by each module header:
+	 *	 - 0x00: uRTCLibJournal, 7 + 8 * URTCLIB_JOURNAL_ENTRIES bytes (39 by default, up to 5 entries)
+	 *	 - 0x30: monotonic offset, 5 bytes (last ones of DS1307 RAM are 0x35 to 0x37)
+	 *	 - 0x80: uRTCLibAgingCal, 6 + 8 * URTCLIB_AGINGCAL_SAMPLES bytes (DS3232 only)
+	 */
+	#ifndef URTCLIB_MONOTONIC_RAM_ADDRESS
+		#define URTCLIB_MONOTONIC_RAM_ADDRESS 0x30
+	#endif
+
+	/**
+	 * \brief Monotonic offset identifier on RAM
+	 */
+	#define URTCLIB_MONOTONIC_MAGIC 0x3C
+
+
+	/************	SNAPSHOT ***********/
+	/**
+	 * \brief Registers stored by uRTCLib::dumpRegisters()
+	 *
+	 * Whole register space: DS1307 64 bytes, DS3231 19 bytes, DS3232 256 bytes. Lower it to save RAM; bigger registers are skipped.
+	 */
+	#ifndef URTCLIB_SNAPSHOT_SIZE
+		#define URTCLIB_SNAPSHOT_SIZE 256
+	#endif
+
 
 	/************	MISC  ***********/
 
@@ -284,6 +663,12 @@
 		 * When this library is used in other MCUs this is simply removed by the preprocessor
 		 */
 		#define uRTCLIB_YIELD yield();
+		/**
+		 * \brief ESP8266, yield to don't block ESP functionality on busy waits.
+		 *
+		 * When this library is used in other MCUs this is simply removed by the preprocessor
+		 */
+		#define uRTCLIB_YIELD_WAIT yield();
 	#else
 		#if ARDUINO_ARCH_ESP32
 		/**
@@ -292,10 +677,18 @@
 		 * When this library is used in other MCUs this is simply removed by the preprocessor
 		 */
 			#define uRTCLIB_YIELD yield();
+		/**
+		 * \brief ESP32, yield to don't block ESP functionality on busy waits.
+		 *
+		 * When this library is used in other MCUs this is simply removed by the preprocessor
+		 */
+			#define uRTCLIB_YIELD_WAIT yield();
 		#else
 			#define uRTCLIB_YIELD
+			#define uRTCLIB_YIELD_WAIT
 		#endif
 	#endif
+
 	
 	#ifdef ARDUINO_ARCH_MEGAAVR
 		/**
@@ -306,6 +699,145 @@
 		#define uRTCLIB_SIZE_T size_t
 	#endif
 
+	/************	YIELD POLICY ***********/
+	/**
+	 * \brief Yield policy - Never yield between I2C transactions
+	 */
+	#define URTCLIB_YIELD_NONE 0
+
+	/**
+	 * \brief Yield policy - Yield after every I2C transaction
+	 */
+	#define URTCLIB_YIELD_TRANSACTION 1
+
+	/**
+	 * \brief Yield policy - Yield after an I2C transaction only when budget microseconds have passed since last yield
+	 */
+	#define URTCLIB_YIELD_BUDGET 2
+
+	/**
+	 * \brief Default yield policy of new instances
+	 *
+	 * #URTCLIB_YIELD_TRANSACTION on ESP8266 and ESP32, #URTCLIB_YIELD_NONE on other MCUs. Define it globally to change it;
+	 * #URTCLIB_YIELD_NONE removes yield code and uRTCLib::yieldPolicy() has no effect.
+	 *
+	 * Busy waits (refreshOnTick(), setPrecise(), uRTCLibOscCal) always yield on ESP.
+	 */
+	#ifndef URTCLIB_YIELD_POLICY
+		#if ARDUINO_ARCH_ESP8266 || ARDUINO_ARCH_ESP32
+			#define URTCLIB_YIELD_POLICY URTCLIB_YIELD_TRANSACTION
+		#else
+			#define URTCLIB_YIELD_POLICY URTCLIB_YIELD_NONE
+		#endif
+	#endif
+
+	/**
+	 * \brief Default budget for #URTCLIB_YIELD_BUDGET, in microseconds
+	 */
+	#ifndef URTCLIB_YIELD_BUDGET_US
+		#define URTCLIB_YIELD_BUDGET_US 2000
+	#endif
+
+	#if URTCLIB_YIELD_POLICY == URTCLIB_YIELD_NONE
+		#define uRTCLIB_YIELD_POINT
+	#else
+		/**
+		 * \brief Yield point between I2C transactions, follows instance yield policy. Only for uRTCLib members.
+		 */
+		#define uRTCLIB_YIELD_POINT _yield();
+	#endif
+
+
+	/**
+	 * \brief RTC time registers image (0x00h to 0x06h, BCD), see uRTCLib::provisionIfUnset()
+	 */
+	struct uRTCLibImage {
+		/**
+		 * \brief Registers: second, minute, hour, day of week, day, month, year
+		 */
+		uint8_t reg[7];
+	};
+
+	/**
+	 * \brief Build timestamp helper - 2 characters to BCD, space as 0
+	 */
+	constexpr uint8_t uRTCLib_buildBcd(const char tens, const char units) {
+		return ((tens == ' ' ? 0 : tens - '0') << 4) | (units - '0');
+	}
+
+	/**
+	 * \brief Build timestamp helper - Month number from __DATE__
+	 */
+	constexpr uint8_t uRTCLib_buildMonth(const char *date) {
+		return date[0] == 'J' ? (date[1] == 'a' ? 1 : (date[2] == 'n' ? 6 : 7)) :
+			date[0] == 'F' ? 2 :
+			date[0] == 'M' ? (date[2] == 'r' ? 3 : 5) :
+			date[0] == 'A' ? (date[1] == 'p' ? 4 : 8) :
+			date[0] == 'S' ? 9 :
+			date[0] == 'O' ? 10 :
+			date[0] == 'N' ? 11 : 12;
+	}
+
+	/**
+	 * \brief Build timestamp helper - Day of week, 1 = Sunday (Sakamoto's method)
+	 */
+	constexpr uint8_t uRTCLib_buildDow(const uint16_t year, const uint8_t month, const uint8_t day) {
+		return ((year - (month < 3)) + (year - (month < 3)) / 4 - (year - (month < 3)) / 100 + (year - (month < 3)) / 400 + "\0\3\2\5\0\3\5\1\4\6\2\4"[month - 1] + day) % 7 + 1;
+	}
+
+	/**
+	 * \brief Build timestamp helper - Registers image from __DATE__ ("Mmm dd yyyy") and __TIME__ ("hh:mm:ss")
+	 */
+	constexpr uRTCLibImage uRTCLib_buildImage(const char *date, const char *time) {
+		return uRTCLibImage { {
+			uRTCLib_buildBcd(time[6], time[7]),
+			uRTCLib_buildBcd(time[3], time[4]),
+			uRTCLib_buildBcd(time[0], time[1]),
+			uRTCLib_buildDow(2000 + (date[9] - '0') * 10 + (date[10] - '0'), uRTCLib_buildMonth(date), (date[4] == ' ' ? 0 : date[4] - '0') * 10 + (date[5] - '0')),
+			uRTCLib_buildBcd(date[4], date[5]),
+			(uint8_t) (0b10000000 | (uRTCLib_buildMonth(date) < 10 ? uRTCLib_buildMonth(date) : uRTCLib_buildMonth(date) + 6)), // century bit, as set()
+			uRTCLib_buildBcd(date[9], date[10])
+		} };
+	}
+
+	/**
+	 * \brief Registers image of this build time, computed at compile time in each file using it
+	 */
+	#define URTCLIB_BUILD_IMAGE uRTCLib_buildImage(__DATE__, __TIME__)
+
+
+	/**
+	 * \brief RTC register space copy, see uRTCLib::dumpRegisters()
+	 */
+	struct uRTCLibSnapshot {
+		/**
+		 * \brief RTC model it was read from
+		 */
+		uint8_t model;
+		/**
+		 * \brief Number of registers stored, from 0x00h
+		 */
+		uint16_t length;
+		/**
+		 * \brief Registers content
+		 */
+		uint8_t reg[URTCLIB_SNAPSHOT_SIZE];
+	};
+
+	/**
+	 * \brief Temperature to aging profile point, see uRTCLib::agingProfileSet()
+	 */
+	struct uRTCLibAgingPoint {
+		/**
+		 * \brief Temperature, degrees * 100 as returned by uRTCLib::temp()
+		 */
+		int16_t temp;
+		/**
+		 * \brief Aging value to use at that temperature
+		 */
+		int8_t aging;
+	};
+
 
 	class uRTCLib {
 		public:
@@ -338,6 +870,45 @@
 			 * @return False on error
 			 */
 			bool refresh();
+			/**
+			 * \brief Waits for next RTC seconds increment and refreshes data just after it
+			 *
+			 * Polls seconds register (1 byte reads) up to 1.1 seconds. Useful to compare RTC against a reference with ms resolution.
+			 *
+			 * @param tickMillis millis() value when seconds increment was detected
+			 *
+			 * @return False on error or timeout
+			 */
+			bool refreshOnTick(unsigned long *);
+			#ifndef URTCLIB_NO_CHANGES
+			/**
+			 * \brief Returns what changed on last refresh()
+			 *
+			 * Computed while decoding from cached values, no extra I2C access. On first refresh fields are compared against 0.
+			 *
+			 * @return Change mask, an OR of:
+			 *	 - #URTCLIB_CHANGE_SECOND
+			 *	 - #URTCLIB_CHANGE_MINUTE
+			 *	 - #URTCLIB_CHANGE_HOUR
+			 *	 - #URTCLIB_CHANGE_DAY
+			 *	 - #URTCLIB_CHANGE_MONTH
+			 *	 - #URTCLIB_CHANGE_ALARM
+			 *	 - #URTCLIB_CHANGE_LOST_POWER
+			 *	 - #URTCLIB_CHANGE_TEMP
+			 */
+			uint8_t changes();
+			/**
+			 * \brief Registers a function to be called from refresh() when selected fields change
+			 *
+			 * Callback receives the whole change mask of that refresh.
+			 *
+			 * @param mask Changes that trigger the callback, see changes()
+			 * @param callback Function to call, NULL to remove all registrations with given mask
+			 *
+			 * @return False if there's no room, see #URTCLIB_CHANGE_CALLBACKS
+			 */
+			bool onChange(const uint8_t, void (*)(const uint8_t));
+			#endif
 			/**
 			 * \brief Returns actual second
 			 *
@@ -397,6 +968,65 @@
 			 *   - #URTCLIB_WEEKDAY_SATURDAY
 			 */
 			uint8_t dayOfWeek();
+			/**
+			 * \brief Returns actual datetime as UNIX timestamp
+			 *
+			 * Year is taken as 20xx. 12 hour mode is taken into account.
+			 *
+			 * @return Current stored datetime, seconds since 1970-01-01 00:00:00
+			 */
+			uint32_t epoch();
+			/**
+			 * \brief Writes actual datetime as text
+			 *
+			 * No printf and no allocation; digits are copied from a 2 digits table. 12 hour mode is taken into account.
+			 *
+			 * @param buffer Destination, at least #URTCLIB_FORMAT_LENGTH bytes
+			 * @param style Text format:
+			 *	 - #URTCLIB_FORMAT_ISO8601
+			 *	 - #URTCLIB_FORMAT_COMPACT
+			 *	 - #URTCLIB_FORMAT_12H
+			 *
+			 * @return Length written, excluding trailing NUL. 0 on wrong parameters.
+			 */
+			uint8_t format(char *, const uint8_t = URTCLIB_FORMAT_ISO8601);
+			/**
+			 * \brief Parses and validates an ISO 8601 datetime
+			 *
+			 * Accepts extended (2024-01-31T23:59:50) and basic (20240131T235950) forms, with 'T' or space as separator and
+			 * optional trailing 'Z'. Year must be 2000 to 2099. Day of week is computed.
+			 *
+			 * @param text Datetime text
+			 * @param data 7 bytes filled in set() parameters order: second, minute, hour, day of week, day, month, year (last 2 digits)
+			 *
+			 * @return False if text is not valid
+			 */
+			static bool parse(const char *, uint8_t *);
+			/**
+			 * \brief Sets RTC datetime from an ISO 8601 text
+			 *
+			 * See parse() for accepted forms.
+			 *
+			 * @param text Datetime text
+			 *
+			 * @return False if text is not valid, RTC is not changed
+			 */
+			bool setFromString(const char *);
+			/**
+			 * \brief Sets RTC to firmware build time if it's not set
+			 *
+			 * Refreshes RTC and, only if it lost power or its time is older than image, writes image in a single 7 bytes
+			 * transaction (plus OSF clearing on DS3231/DS3232). Default image is #URTCLIB_BUILD_IMAGE, expanded where this is called,
+			 * so it's sketch build time (build machine local time) with no runtime parsing.
+			 *
+			 * RTC ends late by the time between build and first boot; use setPrecise() when accuracy matters.
+			 *
+			 * @param image Registers image
+			 *
+			 * @return True if RTC was set
+			 */
+			bool provisionIfUnset(const uRTCLibImage & = URTCLIB_BUILD_IMAGE);
+			#ifndef URTCLIB_NO_TEMP
 			/**
 			 * \brief Returns actual temperature
 			 *
@@ -407,9 +1037,51 @@
 			 * @return Current stored temperature
 			 */
 			int16_t temp();
+			#ifndef URTCLIB_NO_TEMP_CONV
+			/**
+			 * \brief Starts an on-demand temperature conversion
+			 *
+			 * Temperature registers are updated automatically only every 64 seconds. This sets CONV bit on 0x0Eh
+			 * unless a conversion is already running (BSY bit on 0x0Fh). Use tempReady() and tempRead() afterwards.
+			 *
+			 * Only DS3231 and DS3232.
+			 *
+			 * @return False on error or not supported (DS1307)
+			 */
+			bool tempConvert();
+			/**
+			 * \brief Checks if temperature conversion started by tempConvert() has finished
+			 *
+			 * Non-blocking, a single 2 bytes read of 0x0Eh-0x0Fh (CONV and BSY). After #URTCLIB_TEMP_CONV_TIMEOUT ms conversion
+			 * is given up: it returns false until next tempConvert() and tempTimedOut() returns true. Wait with
+			 * while (!rtc.tempReady() && !rtc.tempTimedOut()).
+			 *
+			 * @return True when conversion is finished or none was started; false while running, after timeout or on error
+			 */
+			bool tempReady();
+			/**
+			 * \brief Checks if last temperature conversion was given up
+			 *
+			 * RTC didn't end it in #URTCLIB_TEMP_CONV_TIMEOUT ms, so temperature registers may hold an old value.
+			 *
+			 * @return True if last tempConvert() timed out
+			 */
+			bool tempTimedOut();
+			#endif
+			/**
+			 * \brief Reads only temperature registers (0x11h-0x12h)
+			 *
+			 * Updates value returned by temp() without a full refresh()
+			 *
+			 * @return False on error or not supported (DS1307)
+			 */
+			bool tempRead();
+			#endif
 			/**
 			 * \brief Sets RTC datetime data
 			 *
+			 * Cached datetime is updated too, so there's no need to refresh(). RTC is left in 24 hour mode.
+			 *
 			 * @param second second to set to HW RTC
 			 * @param minute minute to set to HW RTC
 			 * @param hour hour to set to HW RTC
@@ -426,6 +1098,7 @@
 			 * @param year year to set to HW RTC in last 2 digits mode. As RTCs only support 19xx and 20xx years (see datasheets), it's harcoded to 20xx.
 			 */
 			void set(const uint8_t, const uint8_t, const uint8_t, const uint8_t, const uint8_t, const uint8_t, const uint8_t);
+			#ifndef URTCLIB_NO_12H
 			/**
 			 * \brief Set clock in 12 or 24 hour mode
 			 * 12 hour mode has 1-12 hours and AM or PM flag
@@ -435,6 +1108,73 @@
 			 * @param twelveHrMode true or false
 			 */
 			void set_12hour_mode(const bool);
+			#endif
+			#ifndef URTCLIB_NO_PRECISE_SET
+			/**
+			 * \brief Sets RTC datetime data synchronized to a reference instant
+			 *
+			 * Given datetime is the exact time at refMicros (a micros() value). BCD payload is prepared in advance,
+			 * I2C transfer time is measured and the write is issued so it ends on a whole second boundary of the
+			 * reference. As RTC resets its internal divider chain on seconds write, new second phase matches reference.
+			 * When busClock() is set, bus stays at maxClock() from measurement to write, so both run at the same clock.
+			 *
+			 * Datetime written is the given one plus the elapsed whole seconds, so refMicros must be less than ~70 minutes old.
+			 *
+			 * @param second second at refMicros
+			 * @param minute minute at refMicros
+			 * @param hour hour at refMicros
+			 * @param dayOfWeek day of week at refMicros
+			 * @param dayOfMonth day of month at refMicros
+			 * @param month month at refMicros
+			 * @param year year at refMicros in last 2 digits mode
+			 * @param refMicros micros() value when given datetime was exact
+			 *
+			 * @return False on error
+			 */
+			bool setPrecise(const uint8_t, const uint8_t, const uint8_t, const uint8_t, const uint8_t, const uint8_t, const uint8_t, const unsigned long);
+			/**
+			 * \brief Measures phase error of last setPrecise() call
+			 *
+			 * SQWG must be set to #URTCLIB_SQWG_1H and its pin connected to sqwPin. DS3231/DS3232 falling edge marks seconds update.
+			 * Blocks until next falling edge, 1.5 seconds maximum.
+			 *
+			 * @param sqwPin MCU pin connected to SQW output
+			 *
+			 * @return Phase error in microseconds, positive when RTC is late. #URTCLIB_PHASE_ERROR if no edge is seen.
+			 */
+			long setPhaseError(const uint8_t);
+			/**
+			 * \brief Returns I2C transfer time compensated on last setPrecise() call
+			 *
+			 * @return transfer time in microseconds
+			 */
+			unsigned long setLatency();
+			#endif
+			#ifndef URTCLIB_NO_MONOTONIC
+			/**
+			 * \brief Enables monotonic seconds counter
+			 *
+			 * From now on set(), set_12hour_mode() and setPrecise() read RTC time before writing and add the jump to an
+			 * offset, stored on RTC RAM (DS1307 and DS3232) so it survives MCU resets. On DS3231 it's only kept on MCU RAM.
+			 *
+			 * @return True if a stored offset was found; always false on DS3231
+			 */
+			bool monotonicBegin();
+			/**
+			 * \brief Returns monotonic seconds counter
+			 *
+			 * Cached RTC time plus offset, so it doesn't access I2C bus; call refresh() as usual. Never decreases while MCU runs.
+			 *
+			 * @return Seconds, not affected by clock changes
+			 */
+			uint32_t monotonic();
+			/**
+			 * \brief Returns monotonic offset
+			 *
+			 * @return Seconds added to RTC time by monotonic()
+			 */
+			int32_t monotonicOffset();
+			#endif
 			/**
 			 * \brief Sets RTC i2 addres
 			 *
@@ -459,6 +1199,56 @@
 			 *	 - #URTCLIB_MODEL_DS3232
 			 */
 			uint8_t model();
+			#ifndef URTCLIB_NO_DETECT
+			/**
+			 * \brief Detects RTC Model
+			 *
+			 * Non-destructive probe using register pointer wrap-around: DS3231 wraps after 0x12h, DS3232 after 0xFFh
+			 * and DS1307 after 0x3Fh. DS323x temperature LSB register has its 6 lower bits always 0.
+			 * Uses 2 or 3 short reads. Result is cached and set as current model.
+			 *
+			 * @param force Probe again even if there's a cached result
+			 *
+			 * @return Detected model, #URTCLIB_MODEL_UNKNOWN if device doesn't answer or doesn't match any model
+			 *	 - #URTCLIB_MODEL_DS1307
+			 *	 - #URTCLIB_MODEL_DS3231
+			 *	 - #URTCLIB_MODEL_DS3232
+			 *	 - #URTCLIB_MODEL_UNKNOWN
+			 */
+			uint8_t detect(const bool = false);
+			/**
+			 * \brief Returns time spent on last detection probe
+			 *
+			 * @return Time in microseconds
+			 */
+			unsigned long detectMicros();
+			#endif
+
+			/******* Bus clock ********/
+			#ifndef URTCLIB_NO_BUS_CLOCK
+			/**
+			 * \brief Declares I2C clock used by other devices on the bus
+			 *
+			 * When it's set and differs from maxClock(), register transfers (refresh(), RAM, snapshots, temperature...) switch
+			 * the bus to maxClock() and back to this clock, 2 setClock() calls per transfer. Single register configuration
+			 * changes run at bus clock. Default 0: bus clock is never changed.
+			 *
+			 * @param clock Bus clock in Hz, 0 to disable switching
+			 */
+			void busClock(const uint32_t);
+			/**
+			 * \brief Returns I2C clock declared with busClock(const uint32_t)
+			 *
+			 * @return Bus clock in Hz, 0 if switching is disabled
+			 */
+			uint32_t busClock();
+			#endif
+			/**
+			 * \brief Returns maximum I2C clock of current model
+			 *
+			 * @return #URTCLIB_CLOCK_DS1307 or #URTCLIB_CLOCK_DS323X
+			 */
+			uint32_t maxClock();
 
 			/******* Power ********/
 			/**
@@ -519,8 +1309,36 @@
 			  * @return True on success
 			  */
 			bool disableBattery(); // Only DS3231 and DS3232.
+			#ifndef URTCLIB_NO_POWER_PROFILE
+			/**
+			 * \brief Sets power profile
+			 *
+			 * Control (0x0Eh) and Status (0x0Fh) registers are read and written in one burst each.
+			 * On DS3231 only BBSQW is applied.
+			 *
+			 * @param profile Named profile or an OR of bits:
+			 *	 - #URTCLIB_POWER_MAX_ACCURACY
+			 *	 - #URTCLIB_POWER_BALANCED
+			 *	 - #URTCLIB_POWER_MIN_DRAIN
+			 *	 - #URTCLIB_POWER_CRATE_64S, #URTCLIB_POWER_CRATE_128S, #URTCLIB_POWER_CRATE_256S or #URTCLIB_POWER_CRATE_512S
+			 *	 - #URTCLIB_POWER_BB32KHZ
+			 *	 - #URTCLIB_POWER_BBSQW
+			 *
+			 * @return false on error or not supported (DS1307)
+			 */
+			bool powerProfileSet(const uint8_t);
+			/**
+			 * \brief Returns actual power profile
+			 *
+			 * See URTCLIB_POWER_XXXX defines. Compare with named profiles to check them.
+			 *
+			 * @return Current stored power profile. 0b11111111 means error (DS1307).
+			 */
+			uint8_t powerProfile();
+			#endif
 
 
+			#ifndef URTCLIB_NO_ALARMS
 			/******** Alarms ************/
 			/**
 			 * \brief Sets any alarm
@@ -650,7 +1468,126 @@
 			 * @return bool true or false
 			 */
 			bool alarmTriggered(const uint8_t);
+			/**
+			 * \brief Reads alarm flags from RTC
+			 *
+			 * Single byte read of Status register (0x0Fh), no full refresh needed. Updates alarmTriggered() and lostPower() data.
+			 *
+			 * @return Triggered alarms, OR of #URTCLIB_ALARM_FLAG_1 and #URTCLIB_ALARM_FLAG_2. 0 on error or not supported (DS1307).
+			 */
+			uint8_t pollAlarmFlags();
+			/**
+			 * \brief Attaches an ISR to the falling edge of INT/SQW pin
+			 *
+			 * Pin is set as INPUT_PULLUP. Given ISR should just call alarmInterrupt(), i.e.:
+			 * void rtcISR() { rtc.alarmInterrupt(); }
+			 *
+			 * @param pin MCU pin connected to INT/SQW
+			 * @param isr Interrupt service routine
+			 *
+			 * @return False if pin has no interrupt or not supported (DS1307)
+			 */
+			bool alarmInterruptBegin(const uint8_t, void (*)());
+			/**
+			 * \brief Marks INT falling edge, to be called from ISR
+			 *
+			 * Only sets a flag, no I2C access. Work is deferred to alarmHandle().
+			 */
+			void alarmInterrupt();
+			/**
+			 * \brief Deferred alarm handler, call it from loop()
+			 *
+			 * If INT has been marked by alarmInterrupt() it reads Status register (0x0Fh) once, clears only fired
+			 * alarm flags in one write and calls their callbacks. Returns immediately otherwise.
+			 *
+			 * @return Fired alarms, OR of #URTCLIB_ALARM_FLAG_1 and #URTCLIB_ALARM_FLAG_2
+			 */
+			uint8_t alarmHandle();
+			/**
+			 * \brief Sets function to call from alarmHandle() when an alarm fires
+			 *
+			 * @param alarm Alarm number:
+			 *	 - #URTCLIB_ALARM_1
+			 *	 - #URTCLIB_ALARM_2
+			 * @param callback Function to call, NULL to remove it
+			 *
+			 * @return false in case of wrong parameters
+			 */
+			bool alarmCallbackSet(const uint8_t, void (*)());
+			#ifndef URTCLIB_NO_WAKE
+			/**
+			 * \brief Starts a periodic wake timer on Alarm 1
+			 *
+			 * Next wake is cached time (call refresh() before) plus period. Alarm 1 is programmed as #URTCLIB_ALARM_TYPE_1_FIXED_HMS,
+			 * or #URTCLIB_ALARM_TYPE_1_FIXED_DHMS when it's 1 day or more ahead, and A1F is cleared on the same write.
+			 *
+			 * Useful when MCU is reset on each wake: call it on every boot. Schedule is kept in MCU RAM only, so then period must
+			 * not exceed #URTCLIB_WAKE_MAX_STEP; a longer one is split in steps and each boot would start it again from now,
+			 * never reaching its end.
+			 *
+			 * @param period Seconds between wakes
+			 *
+			 * @return false in case of not supported (DS1307), wrong parameters or error
+			 */
+			bool wakeEvery(const uint32_t);
+			/**
+			 * \brief Programs next wake of periodic wake timer
+			 *
+			 * Call it after wake with refreshed time. If A1F is set next wake is computed from schedule, skipping missed ones,
+			 * and Alarm 1 and A1F clearing are written in a single transaction. No write is done if A1F isn't set.
+			 *
+			 * @return True if a period has elapsed; false on intermediate steps of periods longer than #URTCLIB_WAKE_MAX_STEP, if A1F isn't set or on error
+			 */
+			bool wakeRearm();
+			/**
+			 * \brief Stops periodic wake timer and disables Alarm 1
+			 *
+			 * @return false in case of not supported (DS1307)
+			 */
+			bool wakeStop();
+			/**
+			 * \brief Returns next scheduled wake of periodic wake timer
+			 *
+			 * @return UNIX timestamp, 0 if wake timer is not running
+			 */
+			uint32_t wakeNext();
+			/**
+			 * \brief Starts a hardware watchdog on Alarm 2
+			 *
+			 * Alarm 2 is set to match minutes (#URTCLIB_ALARM_TYPE_2_FIXED_M) timeout minutes ahead and its interrupt is enabled,
+			 * so INT pin gets LOW if watchdogKick() isn't called in time. Connect INT to MCU reset through a capacitor, as on deepsleep
+			 * example, because INT remains LOW until A2F is cleared. Call it on every boot; it clears A2F.
+			 *
+			 * Actual timeout is between timeout - 1 and timeout minutes. Alarm 2 can't be used for anything else meanwhile.
+			 *
+			 * @param timeout Minutes, 2 to 59
+			 *
+			 * @return false in case of not supported (DS1307), wrong parameters or error
+			 */
+			bool watchdogBegin(const uint8_t);
+			/**
+			 * \brief Feeds watchdog
+			 *
+			 * Call it often from main loop. Only once each #URTCLIB_WATCHDOG_KICK_INTERVAL ms it accesses RTC: reads minutes
+			 * register and writes Alarm 2 minutes register, 1 byte each. Other calls only check millis().
+			 */
+			void watchdogKick();
+			/**
+			 * \brief Stops watchdog and disables Alarm 2
+			 *
+			 * @return false in case of not supported (DS1307)
+			 */
+			bool watchdogStop();
+			/**
+			 * \brief Checks if watchdog had fired before last watchdogBegin()
+			 *
+			 * @return True if A2F was set, so last reset was probably caused by watchdog
+			 */
+			bool watchdogFired();
+			#endif
+			#endif
 
+			#ifndef URTCLIB_NO_SQWG
 			/*********** SQWG ************/
 			/**
 			 * \brief Changes SQWG mode, including turning it off
@@ -680,8 +1617,10 @@
 			 *	 - #URTCLIB_SQWG_32768H
 			 */
 			bool sqwgSetMode(const uint8_t);
+			#endif
 
 
+			#ifndef URTCLIB_NO_RAM
 			/************ RAM *************/
 			// Only DS1307 and DS3232.
 			// DS1307: Addresses 08h to 3Fh so we offset 08h positions and limit to 38h as maximum address
@@ -703,7 +1642,33 @@
 			 * @return true if correct
 			 */
 			bool ramWrite(const uint8_t, byte);
+			/**
+			 * \brief Reads a block from RTC RAM
+			 *
+			 * Reads in #URTCLIB_WIRE_BURST bytes transactions
+			 *
+			 * @param address RAM Address of first byte
+			 * @param data Buffer to store content
+			 * @param length Number of bytes to read
+			 *
+			 * @return true if correct
+			 */
+			bool ramReadBlock(const uint8_t, byte *, const uint8_t);
+			/**
+			 * \brief Writes a block to RTC RAM
+			 *
+			 * Writes in #URTCLIB_WIRE_BURST bytes transactions, register address included
+			 *
+			 * @param address RAM Address of first byte
+			 * @param data Content to write
+			 * @param length Number of bytes to write
+			 *
+			 * @return true if correct
+			 */
+			bool ramWriteBlock(const uint8_t, const byte *, const uint8_t);
+			#endif
 
+			#ifndef URTCLIB_NO_AGING
 			/************ Aging *************/
 			// Only DS3231 and DS3232. Address 0x10h
 			/**
@@ -720,7 +1685,31 @@
 			 * @return True when executed, false if RTC doesn't support it.
 			 */
 			bool agingSet(int8_t);
+			#endif
+			#ifndef URTCLIB_NO_AGING_PROFILE
+			/**
+			 * \brief Sets a temperature indexed aging profile
+			 *
+			 * After each temperature read (refresh() or tempRead()) aging is interpolated from the table and written
+			 * with agingSet() only when resulting value changes. Temperatures out of table range use first or last point.
+			 *
+			 * Table is not copied, it must stay valid. Only DS3231 and DS3232.
+			 *
+			 * @param table Profile points, sorted by ascending temperature. NULL disables profile.
+			 * @param points Number of points
+			 */
+			void agingProfileSet(const uRTCLibAgingPoint *, const uint8_t);
+			/**
+			 * \brief Interpolates aging value for a temperature from active profile
+			 *
+			 * @param temp Temperature, degrees * 100
+			 *
+			 * @return Aging value, 0 if there's no profile
+			 */
+			int8_t agingProfileGet(const int16_t);
+			#endif
 
+			#ifndef URTCLIB_NO_32K
 			/************ 32K Generator pin *************/
 			// Only DS3231 and DS3232. On DS1307 we map it to SqWG
 			/**
@@ -742,13 +1731,118 @@
 			 * As DS1307 doen't have this functionality we map it to SqWG with 32K frequency
 			 */
 			bool status32KOut();
+			#endif
+
+			/************ Registers snapshot *************/
+			/**
+			 * \brief Reads whole RTC register space, including RAM
+			 *
+			 * Reads up to #URTCLIB_SNAPSHOT_SIZE registers, in as few transactions as #URTCLIB_WIRE_BUFFER allows.
+			 *
+			 * @param snapshot Where to store registers
+			 *
+			 * @return False on error
+			 */
+			bool dumpRegisters(uRTCLibSnapshot &);
+			/**
+			 * \brief Writes a snapshot back, only registers that differ from RTC
+			 *
+			 * RTC is read again in #URTCLIB_WIRE_BURST - 1 bytes blocks and each run of different registers is written in a single transaction.
+			 * On DS3231/DS3232 temperature registers are skipped, CONV is never set and Status register flags (OSF, A1F, A2F) are
+			 * kept, even when set during restore; only its configuration bits are restored. Cached data is refreshed at the end.
+			 *
+			 * Useful to clone a configured RTC to a replacement of same model.
+			 *
+			 * @param snapshot Registers to restore, from dumpRegisters()
+			 * @param time Restore also time registers (0x00h to 0x06h)
+			 *
+			 * @return Number of registers written, -1 on error or different model
+			 */
+			int16_t restoreRegisters(const uRTCLibSnapshot &, const bool = false);
+			/**
+			 * \brief Finds next different register between 2 snapshots
+			 *
+			 * Call it again with returned address + 1 to get the next one.
+			 *
+			 * @param a First snapshot
+			 * @param b Second snapshot
+			 * @param from First register to compare
+			 *
+			 * @return Register address, -1 if there are no more differences
+			 */
+			static int16_t diffRegisters(const uRTCLibSnapshot &, const uRTCLibSnapshot &, const uint16_t = 0);
+
+			/************ Yield policy *************/
+			/**
+			 * \brief Sets yield policy of this instance
+			 *
+			 * Yield points are placed between I2C transactions, never inside them nor inside setPrecise() transfer time measurement. No effect if #URTCLIB_YIELD_POLICY is #URTCLIB_YIELD_NONE.
+			 *
+			 * @param policy Yield policy:
+			 *	 - #URTCLIB_YIELD_NONE
+			 *	 - #URTCLIB_YIELD_TRANSACTION
+			 *	 - #URTCLIB_YIELD_BUDGET
+			 * @param budget Microseconds between yields for #URTCLIB_YIELD_BUDGET
+			 */
+			void yieldPolicy(const uint8_t, const uint16_t = URTCLIB_YIELD_BUDGET_US);
+			/**
+			 * \brief Returns yield policy of this instance
+			 *
+			 * @return Yield policy, #URTCLIB_YIELD_NONE if yield code is not compiled
+			 */
+			uint8_t yieldPolicy();
 
 
 		private:
 			// Address
 			int _rtc_address = URTCLIB_ADDRESS;
 
+			#ifdef URTCLIB_PACKED
+			// Packed layout, see #URTCLIB_PACKED. Widths fit any decoded register value, i.e. BCD 0x7F is 85.
+			// Bit-fields can't have default member initializers, they're set by _packedInit()
+			uint32_t _second : 7;
+			uint32_t _minute : 7;
+			uint32_t _hour : 6;
+			uint32_t _month : 5;
+			uint32_t _model : 2;
+			#ifndef URTCLIB_NO_DETECT
+			uint32_t _detected_model : 2;
+			#endif
+			#ifndef URTCLIB_NO_MONOTONIC
+			uint32_t _monotonic : 1;
+			#endif
+			uint32_t _dayOfWeek : 8;
+			uint32_t _day : 8;
+			uint32_t _year : 8;
+			#ifndef URTCLIB_NO_POWER_PROFILE
+			uint32_t _power_profile : 4;
+			#endif
+			#ifndef URTCLIB_NO_TEMP_CONV
+			uint32_t _tempConvState : 2;
+			#endif
+			#ifndef URTCLIB_NO_ALARMS
+			uint32_t _a1_mode : 6;
+			uint32_t _a1_second : 7;
+			uint32_t _a1_minute : 7;
+			uint32_t _a1_hour : 6;
+			uint32_t _a1_day_dow : 6;
+			uint32_t _a2_mode : 8;
+			uint32_t _a2_minute : 7;
+			uint32_t _a2_hour : 6;
+			uint32_t _a2_day_dow : 6;
+			#endif
+			#ifndef URTCLIB_NO_WAKE
+			uint32_t _watchdogFired : 1;
+			uint16_t _watchdogTimeout : 6;
+			#endif
+			#ifndef URTCLIB_NO_SQWG
+			uint16_t _sqwg_mode : 8;
+			#endif
+			void _packedInit();
+			#endif
+
 			// RTC read data
+			#ifndef URTCLIB_PACKED
 			uint8_t _second = 0;
 			uint8_t _minute = 0;
 			uint8_t _hour = 0;
@@ -756,12 +1850,32 @@
 			uint8_t _month = 0;
 			uint8_t _year = 0;
 			uint8_t _dayOfWeek = 0;
+			#endif
+			#ifndef URTCLIB_NO_TEMP
 			int16_t _temp = 9999;
+			static int16_t _tempDecode(const uint8_t, const uint8_t);
+			#endif
+			#ifndef URTCLIB_NO_TEMP_CONV
+			#ifndef URTCLIB_PACKED
+			uint8_t _tempConvState = 0; // 0 none or finished, 1 running, 2 timed out
+			#endif
+			unsigned long _tempConvStart = 0;
+			#endif
 
 			// Model, for alarms and RAM
+			#ifndef URTCLIB_PACKED
 			uint8_t _model = URTCLIB_MODEL_DS3232;
-
+			#endif
+			#ifndef URTCLIB_NO_DETECT
+			#ifndef URTCLIB_PACKED
+			uint8_t _detected_model = URTCLIB_MODEL_UNKNOWN;
+			#endif
+			unsigned long _detect_micros = 0;
+			#endif
+
+			#ifndef URTCLIB_NO_ALARMS
 			// Alarms:
+			#ifndef URTCLIB_PACKED
 			uint8_t _a1_mode = URTCLIB_ALARM_TYPE_1_NONE;
 			uint8_t _a1_second = 0;
 			uint8_t _a1_minute = 0;
@@ -773,13 +1887,67 @@
 			uint8_t _a2_minute = 0;
 			uint8_t _a2_hour = 0;
 			uint8_t _a2_day_dow = 0;
+			#endif
 			// bool _a2_triggered_flag = _controlStatus  Bit 1
 
+			// Alarm interrupt
+			volatile bool _alarm_pending = false;
+			void (*_a1_callback)() = NULL;
+			void (*_a2_callback)() = NULL;
+			#endif
+
+			#ifndef URTCLIB_NO_WAKE
+			// Wake timer
+			uint32_t _wakePeriod = 0;
+			uint32_t _wakeNext = 0;
+			bool _wakeArm(const bool);
+
+			// Watchdog
+			unsigned long _watchdogStamp = 0;
+			#ifndef URTCLIB_PACKED
+			uint8_t _watchdogTimeout = 0;
+			bool _watchdogFired = false;
+			#endif
+			#endif
+
+			// Yield policy
+			#if URTCLIB_YIELD_POLICY != URTCLIB_YIELD_NONE
+			uint8_t _yield_policy = URTCLIB_YIELD_POLICY;
+			uint16_t _yield_budget = URTCLIB_YIELD_BUDGET_US;
+			unsigned long _yield_stamp = 0;
+			void _yield();
+			#endif
+
+			// Change notification
+			#ifndef URTCLIB_NO_CHANGES
+			uint8_t _changes = 0;
+			uint8_t _change_masks[URTCLIB_CHANGE_CALLBACKS] = { };
+			void (*_change_callbacks[URTCLIB_CHANGE_CALLBACKS])(const uint8_t) = { };
+			#endif
+
 			// Aging
+			#ifndef URTCLIB_NO_AGING
 			int8_t _aging = 0;
-
+			#endif
+			#ifndef URTCLIB_NO_AGING_PROFILE
+			const uRTCLibAgingPoint *_agingProfile = NULL;
+			uint8_t _agingProfilePoints = 0;
+			int16_t _agingProfileTemp = URTCLIB_TEMP_ERROR;
+			int16_t _agingProfileTarget = URTCLIB_TEMP_ERROR; // Out of int8_t range, forces 1st write
+			void _agingProfileApply();
+			#endif
+
+			#ifndef URTCLIB_PACKED
 			// SQWG
+			#ifndef URTCLIB_NO_SQWG
 			uint8_t _sqwg_mode = URTCLIB_SQWG_OFF_1;
+			#endif
+
+			// Power profile
+			#ifndef URTCLIB_NO_POWER_PROFILE
+			uint8_t _power_profile = URTCLIB_POWER_CRATE_64S;
+			#endif
+			#endif
 
 			// Keep record of various Flags
 			// _controlStatus  MSB Bit 7    _lost_power        = (bool) (_controlStatus & 0b10000000);    // Lost power flag
@@ -792,6 +1960,49 @@
 			// _controlStatus  LSB Bit 0    _a1_triggered_flag = (bool) (_controlStatus & 0b00000001);    // Alarm 1 triggered flag
 			uint8_t _controlStatus = 0x00;
 
+			// Precise set
+			#ifndef URTCLIB_NO_PRECISE_SET
+			unsigned long _setBoundaryMicros = 0;
+			unsigned long _setLatencyMicros = 0;
+			#endif
+
+			// Monotonic counter
+			#ifndef URTCLIB_NO_MONOTONIC
+			#ifndef URTCLIB_PACKED
+			bool _monotonic = false;
+			#endif
+			int32_t _monotonicOffset = 0;
+			uint32_t _monotonicLast = 0;
+			bool _readEpoch(uint32_t *);
+			void _monotonicAdjust(const uint32_t, const uint32_t);
+			#endif
+			void _setCache(const uint8_t *);
+
+			// Date helpers, year as last 2 digits of 20xx
+			static uint8_t _daysInMonth(const uint8_t, const uint8_t);
+			static uint32_t _dateToUnix(const uint8_t, const uint8_t, const uint8_t, const uint8_t, const uint8_t, const uint8_t);
+			static void _unixToDate(uint32_t, uint8_t *);
+			static uint32_t _registersToUnix(const uint8_t *);
+
+			// I2C helpers
+			#ifndef URTCLIB_NO_BUS_CLOCK
+			uint32_t _bus_clock = 0;
+			bool _clockSwitch(const bool);
+			#endif
+			bool _readRegisters(const uint8_t, uint8_t *, const uint16_t);
+			bool _readChunks(const uint8_t, uint8_t *, const uint16_t);
+			bool _writeRegisters(const uint8_t, const uint8_t *, const uint16_t);
+			bool _writeChunks(const uint8_t, const uint8_t *, const uint16_t);
+
+			// RAM helper
+			#ifndef URTCLIB_NO_RAM
+			uint8_t _ramOffset(const uint8_t, const uint8_t);
+			#endif
+
+			// Snapshot helpers
+			uint16_t _registerSpace();
+			bool _restoreByte(const uint8_t, const uint8_t, const uint8_t, uint8_t *);
+
 	};
 
 #endif
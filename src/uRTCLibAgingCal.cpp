@@ -0,0 +1,301 @@
+/**
+ * \class uRTCLibAgingCal
+ * \brief Automatic aging offset calibration for DS3231 and DS3232
+ *
+ * Compares RTC against an external time reference (NTP over serial, GPS PPS, host clock...), fits RTC offset
+ * over time and adjusts aging register when error is bigger than hysteresis.
+ *
+ * On DS3232 calibration state is kept on RTC SRAM, so it survives MCU resets.
+ *
+ * @file uRTCLibAgingCal.cpp
+ * @copyright Naguissa
+ * @author Naguissa
+ * @see <a href="https://github.com/Naguissa/uRTCLib">https://github.com/Naguissa/uRTCLib</a>
+ * @see <a href="mailto:naguissa@foroelectro.net">naguissa@foroelectro.net</a>
+ * @version 6.9.9
+ */
+#include <Arduino.h>
+#include "uRTCLibAgingCal.h"
+
+#ifndef URTCLIB_NO_AGING // Needs aging register
+
+/**
+ * \brief Constructor
+ *
+ * @param rtc uRTCLib instance to calibrate
+ */
+uRTCLibAgingCal::uRTCLibAgingCal(uRTCLib &rtc) {
+	_rtc = &rtc;
+}
+
+/**
+ * \brief Restores calibration state from RTC RAM
+ *
+ * Only DS3232, other models start empty.
+ *
+ * @return True if a stored state was found
+ */
+bool uRTCLibAgingCal::begin() {
+	#ifdef URTCLIB_NO_RAM
+	_count = 0;
+	return false;
+	#else
+	byte data[6 + 8 * URTCLIB_AGINGCAL_SAMPLES];
+	uint8_t i, j;
+	_count = 0;
+	if (_rtc->model() != URTCLIB_MODEL_DS3232) {
+		return false;
+	}
+	if (!_rtc->ramReadBlock(URTCLIB_AGINGCAL_RAM_ADDRESS, data, sizeof(data))) {
+		return false;
+	}
+	if (data[0] != URTCLIB_AGINGCAL_MAGIC || data[1] > URTCLIB_AGINGCAL_SAMPLES) {
+		return false;
+	}
+	_base = 0;
+	for (j = 0; j < 4; j++) {
+		_base |= (uint32_t) data[2 + j] << (8 * j);
+	}
+	for (i = 0; i < data[1]; i++) {
+		_x[i] = 0;
+		_y[i] = 0;
+		for (j = 0; j < 4; j++) {
+			_x[i] |= (uint32_t) data[6 + 8 * i + j] << (8 * j);
+			_y[i] |= (uint32_t) data[10 + 8 * i + j] << (8 * j);
+		}
+	}
+	_count = data[1];
+	return true;
+	#endif
+}
+
+/**
+ * \brief Adds a reference sample
+ *
+ * Waits for next RTC second increment (up to 1.1s) to measure offset with ms resolution, then fits
+ * all samples and applies aging change when needed.
+ *
+ * State is stored on RTC RAM only when a new fit starts or estimated aging change (in LSB) varies.
+ *
+ * For a GPS PPS pin: refUnix is the time of the pulse, refMillis is 0 and refStamp is millis() at pulse.
+ *
+ * @param refUnix Reference time, UNIX timestamp
+ * @param refMillis Reference time, milliseconds part
+ * @param refStamp millis() value when reference time was valid
+ *
+ * @return False on RTC error
+ */
+bool uRTCLibAgingCal::sample(const uint32_t refUnix, const uint16_t refMillis, const unsigned long refStamp) {
+	unsigned long tick;
+	uint32_t refSeconds, refMs;
+	int32_t offset, ppb = _ppb;
+	int16_t step;
+	uint8_t i;
+
+	if (!_rtc->refreshOnTick(&tick)) {
+		return false;
+	}
+	// Reference time when RTC second started
+	refMs = refMillis + (tick - refStamp);
+	refSeconds = refUnix + refMs / 1000;
+	refMs %= 1000;
+	offset = (int32_t) (_rtc->epoch() - refSeconds) * 1000L - (int32_t) refMs;
+
+	if (_count == 0) {
+		_base = refSeconds;
+	}
+	if (_count == URTCLIB_AGINGCAL_SAMPLES) { // Drop oldest one
+		for (i = 1; i < _count; i++) {
+			_x[i - 1] = _x[i];
+			_y[i - 1] = _y[i];
+		}
+		_count--;
+	}
+	_x[_count] = refSeconds - _base;
+	_y[_count] = offset;
+	_count++;
+
+	if (_count >= 3 && _x[_count - 1] - _x[0] >= URTCLIB_AGINGCAL_MIN_SPAN) {
+		_ppb = fit(_x, _y, _count);
+		// Positive aging slows oscillator down
+		step = _lsb(_ppb);
+		if (step >= URTCLIB_AGINGCAL_HYSTERESIS || step <= -URTCLIB_AGINGCAL_HYSTERESIS) {
+			step += _rtc->agingGet();
+			if (step > 127) {
+				step = 127;
+			} else if (step < -128) {
+				step = -128;
+			}
+			_lastStep = step - _rtc->agingGet();
+			_rtc->agingSet((int8_t) step);
+			// Rate has changed, start a new fit from this point
+			_base = refSeconds;
+			_x[0] = 0;
+			_y[0] = offset;
+			_count = 1;
+		}
+	}
+	// Stored samples only matter to restore the estimate, don't write RAM on each sample
+	if (_count == 1 || _lsb(_ppb) != _lsb(ppb)) {
+		_save();
+	}
+	return true;
+}
+
+/**
+ * \brief Discards all samples
+ */
+void uRTCLibAgingCal::reset() {
+	_count = 0;
+	_ppb = 0;
+	_save();
+}
+
+/**
+ * \brief Returns last fitted RTC frequency error
+ *
+ * @return Error in ppb, positive when RTC runs fast
+ */
+int32_t uRTCLibAgingCal::ppb() {
+	return _ppb;
+}
+
+/**
+ * \brief Returns last measured RTC offset
+ *
+ * @return RTC minus reference, in milliseconds
+ */
+int32_t uRTCLibAgingCal::offset() {
+	return _count ? _y[_count - 1] : 0;
+}
+
+/**
+ * \brief Returns number of stored samples
+ *
+ * @return Samples count
+ */
+uint8_t uRTCLibAgingCal::samples() {
+	return _count;
+}
+
+/**
+ * \brief Returns last aging change applied
+ *
+ * @return Aging LSB change, 0 if none yet
+ */
+int8_t uRTCLibAgingCal::lastStep() {
+	return _lastStep;
+}
+
+#ifndef URTCLIB_NO_TEMP
+/**
+ * \brief Learns a temperature profile point from current RTC temperature and aging
+ *
+ * Call it once calibration has settled at a temperature. Nearest point closer than #URTCLIB_AGINGCAL_LEARN_SPAN
+ * is updated, otherwise a new point is inserted keeping table sorted. Use table with uRTCLib::agingProfileSet().
+ *
+ * @param table Profile points, sorted by ascending temperature
+ * @param points Number of points in use
+ * @param maxPoints Table capacity
+ *
+ * @return New number of points in use
+ */
+uint8_t uRTCLibAgingCal::learn(uRTCLibAgingPoint *table, uint8_t points, const uint8_t maxPoints) {
+	int16_t temp = _rtc->temp(), diff;
+	uint8_t i, pos = 0;
+	if (temp == URTCLIB_TEMP_ERROR) {
+		return points;
+	}
+	for (i = 0; i < points; i++) {
+		diff = table[i].temp - temp;
+		if (diff < URTCLIB_AGINGCAL_LEARN_SPAN && diff > -URTCLIB_AGINGCAL_LEARN_SPAN) {
+			table[i].aging = _rtc->agingGet();
+			return points;
+		}
+		if (table[i].temp < temp) {
+			pos = i + 1;
+		}
+	}
+	if (points >= maxPoints) {
+		return points;
+	}
+	for (i = points; i > pos; i--) {
+		table[i] = table[i - 1];
+	}
+	table[pos].temp = temp;
+	table[pos].aging = _rtc->agingGet();
+	return points + 1;
+}
+#endif
+
+/**
+ * \brief Fits RTC offset samples by least squares
+ *
+ * @param x Sample times, seconds since first sample
+ * @param y RTC offsets, milliseconds
+ * @param count Number of samples
+ *
+ * @return Slope in ppb
+ */
+int32_t uRTCLibAgingCal::fit(const uint32_t *x, const int32_t *y, const uint8_t count) {
+	float meanX = 0, meanY = 0, sxx = 0, sxy = 0, dx;
+	uint8_t i;
+	if (count < 2) {
+		return 0;
+	}
+	for (i = 0; i < count; i++) {
+		meanX += x[i];
+		meanY += y[i];
+	}
+	meanX /= count;
+	meanY /= count;
+	for (i = 0; i < count; i++) {
+		dx = x[i] - meanX;
+		sxx += dx * dx;
+		sxy += dx * (y[i] - meanY);
+	}
+	if (sxx == 0) {
+		return 0;
+	}
+	return (int32_t) (sxy / sxx * 1000000.0); // ms/s to ppb
+}
+
+/**
+ * \brief Converts a frequency error to aging LSB, rounded
+ *
+ * @param ppb Error in ppb
+ *
+ * @return Aging LSB
+ */
+int16_t uRTCLibAgingCal::_lsb(const int32_t ppb) {
+	return (ppb + (ppb < 0 ? -URTCLIB_AGINGCAL_PPB_PER_LSB / 2 : URTCLIB_AGINGCAL_PPB_PER_LSB / 2)) / URTCLIB_AGINGCAL_PPB_PER_LSB;
+}
+
+/**
+ * \brief Stores calibration state on RTC RAM
+ *
+ * Only DS3232
+ */
+void uRTCLibAgingCal::_save() {
+	#ifndef URTCLIB_NO_RAM
+	byte data[6 + 8 * URTCLIB_AGINGCAL_SAMPLES];
+	uint8_t i, j;
+	if (_rtc->model() != URTCLIB_MODEL_DS3232) {
+		return;
+	}
+	data[0] = URTCLIB_AGINGCAL_MAGIC;
+	data[1] = _count;
+	for (j = 0; j < 4; j++) {
+		data[2 + j] = _base >> (8 * j);
+	}
+	for (i = 0; i < _count; i++) {
+		for (j = 0; j < 4; j++) {
+			data[6 + 8 * i + j] = _x[i] >> (8 * j);
+			data[10 + 8 * i + j] = (uint32_t) _y[i] >> (8 * j);
+		}
+	}
+	_rtc->ramWriteBlock(URTCLIB_AGINGCAL_RAM_ADDRESS, data, 6 + 8 * _count);
+	#endif
+}
+
+#endif
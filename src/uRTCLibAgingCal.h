@@ -0,0 +1,187 @@
+/**
+ * \class uRTCLibAgingCal
+ * \brief Automatic aging offset calibration for DS3231 and DS3232
+ *
+ * Compares RTC against an external time reference (NTP over serial, GPS PPS, host clock...), fits RTC offset
+ * over time and adjusts aging register when error is bigger than hysteresis.
+ *
+ * On DS3232 calibration state is kept on RTC SRAM, so it survives MCU resets.
+ *
+ * @file uRTCLibAgingCal.h
+ * @copyright Naguissa
+ * @author Naguissa
+ * @see <a href="https://github.com/Naguissa/uRTCLib">https://github.com/Naguissa/uRTCLib</a>
+ * @see <a href="mailto:naguissa@foroelectro.net">naguissa@foroelectro.net</a>
+ * @version 6.9.9
+ */
+#ifndef URTCLIBAGINGCAL
+	/**
+	 * \brief Prevent multiple inclussion
+	 */
+	#define URTCLIBAGINGCAL
+	#include "Arduino.h"
+	#include "uRTCLib.h"
+
+	#ifndef URTCLIB_NO_AGING // Needs aging register
+
+	/**
+	 * \brief Number of reference samples used on linear fit
+	 */
+	#ifndef URTCLIB_AGINGCAL_SAMPLES
+		#define URTCLIB_AGINGCAL_SAMPLES 8
+	#endif
+
+	/**
+	 * \brief Minimum time span, in seconds, between first and last sample before adjusting aging
+	 *
+	 * 6 hours by default
+	 */
+	#ifndef URTCLIB_AGINGCAL_MIN_SPAN
+		#define URTCLIB_AGINGCAL_MIN_SPAN 21600UL
+	#endif
+
+	/**
+	 * \brief Minimum aging change, in LSB, to be applied
+	 */
+	#ifndef URTCLIB_AGINGCAL_HYSTERESIS
+		#define URTCLIB_AGINGCAL_HYSTERESIS 2
+	#endif
+
+	/**
+	 * \brief Frequency change per aging LSB, in ppb
+	 *
+	 * Typical value at 25ºC is 0.1ppm
+	 */
+	#ifndef URTCLIB_AGINGCAL_PPB_PER_LSB
+		#define URTCLIB_AGINGCAL_PPB_PER_LSB 100
+	#endif
+
+	/**
+	 * \brief RAM address where calibration state is stored (DS3232 only)
+	 *
+	 * Uses 6 + 8 * #URTCLIB_AGINGCAL_SAMPLES bytes
+	 */
+	#ifndef URTCLIB_AGINGCAL_RAM_ADDRESS
+		#define URTCLIB_AGINGCAL_RAM_ADDRESS 0x80
+	#endif
+
+	#if !defined(URTCLIB_NO_MONOTONIC) && URTCLIB_AGINGCAL_RAM_ADDRESS < URTCLIB_MONOTONIC_RAM_ADDRESS + 5 && URTCLIB_MONOTONIC_RAM_ADDRESS < URTCLIB_AGINGCAL_RAM_ADDRESS + 6 + 8 * URTCLIB_AGINGCAL_SAMPLES
+		#error "uRTCLibAgingCal RAM area overlaps monotonic offset: move URTCLIB_AGINGCAL_RAM_ADDRESS or URTCLIB_MONOTONIC_RAM_ADDRESS"
+	#endif
+
+	/**
+	 * \brief Temperature distance, degrees * 100, under which learn() updates an existing profile point
+	 */
+	#ifndef URTCLIB_AGINGCAL_LEARN_SPAN
+		#define URTCLIB_AGINGCAL_LEARN_SPAN 200
+	#endif
+
+	/**
+	 * \brief Calibration state identifier on RAM
+	 */
+	#define URTCLIB_AGINGCAL_MAGIC 0xA6
+
+
+	class uRTCLibAgingCal {
+		public:
+			/**
+			 * \brief Constructor
+			 *
+			 * @param rtc uRTCLib instance to calibrate
+			 */
+			uRTCLibAgingCal(uRTCLib &);
+			/**
+			 * \brief Restores calibration state from RTC RAM
+			 *
+			 * Only DS3232, other models start empty.
+			 *
+			 * @return True if a stored state was found
+			 */
+			bool begin();
+			/**
+			 * \brief Adds a reference sample
+			 *
+			 * Waits for next RTC second increment (up to 1.1s) to measure offset with ms resolution, then fits
+			 * all samples and applies aging change when needed.
+			 *
+			 * State is stored on RTC RAM only when a new fit starts or estimated aging change (in LSB) varies.
+			 *
+			 * For a GPS PPS pin: refUnix is the time of the pulse, refMillis is 0 and refStamp is millis() at pulse.
+			 *
+			 * @param refUnix Reference time, UNIX timestamp
+			 * @param refMillis Reference time, milliseconds part
+			 * @param refStamp millis() value when reference time was valid
+			 *
+			 * @return False on RTC error
+			 */
+			bool sample(const uint32_t, const uint16_t, const unsigned long);
+			/**
+			 * \brief Discards all samples
+			 */
+			void reset();
+			/**
+			 * \brief Returns last fitted RTC frequency error
+			 *
+			 * @return Error in ppb, positive when RTC runs fast
+			 */
+			int32_t ppb();
+			/**
+			 * \brief Returns last measured RTC offset
+			 *
+			 * @return RTC minus reference, in milliseconds
+			 */
+			int32_t offset();
+			/**
+			 * \brief Returns number of stored samples
+			 *
+			 * @return Samples count
+			 */
+			uint8_t samples();
+			/**
+			 * \brief Returns last aging change applied
+			 *
+			 * @return Aging LSB change, 0 if none yet
+			 */
+			int8_t lastStep();
+			#ifndef URTCLIB_NO_TEMP
+			/**
+			 * \brief Learns a temperature profile point from current RTC temperature and aging
+			 *
+			 * Call it once calibration has settled at a temperature. Nearest point closer than #URTCLIB_AGINGCAL_LEARN_SPAN
+			 * is updated, otherwise a new point is inserted keeping table sorted. Use table with uRTCLib::agingProfileSet().
+			 *
+			 * @param table Profile points, sorted by ascending temperature
+			 * @param points Number of points in use
+			 * @param maxPoints Table capacity
+			 *
+			 * @return New number of points in use
+			 */
+			uint8_t learn(uRTCLibAgingPoint *, uint8_t, const uint8_t);
+			#endif
+			/**
+			 * \brief Fits RTC offset samples by least squares
+			 *
+			 * @param x Sample times, seconds since first sample
+			 * @param y RTC offsets, milliseconds
+			 * @param count Number of samples
+			 *
+			 * @return Slope in ppb
+			 */
+			static int32_t fit(const uint32_t *, const int32_t *, const uint8_t);
+
+		private:
+			uRTCLib *_rtc;
+			uint32_t _base = 0;
+			uint32_t _x[URTCLIB_AGINGCAL_SAMPLES];
+			int32_t _y[URTCLIB_AGINGCAL_SAMPLES];
+			uint8_t _count = 0;
+			int32_t _ppb = 0;
+			int8_t _lastStep = 0;
+
+			void _save();
+			static int16_t _lsb(const int32_t);
+	};
+
+	#endif
+
+#endif
@@ -0,0 +1,203 @@
+/**
+ * \class uRTCLibJournal
+ * \brief Power-outage journal on RTC RAM for DS1307 and DS3232
+ *
+ * heartbeat() periodically stores current RTC time on RAM. On next boot begin() compares it with RTC time,
+ * so downtime duration is known (with heartbeat period resolution) and added to a small outage history.
+ *
+ * An outage of unknown duration (RTC lost power too) is recorded once, even if lost power flag stays set on next
+ * boots. Once it's cleared (uRTCLib::lostPowerClear(), after setting time) a new one can be recorded.
+ *
+ * @file uRTCLibJournal.cpp
+ * @copyright Naguissa
+ * @author Naguissa
+ * @see <a href="https://github.com/Naguissa/uRTCLib">https://github.com/Naguissa/uRTCLib</a>
+ * @see <a href="mailto:naguissa@foroelectro.net">naguissa@foroelectro.net</a>
+ * @version 6.9.9
+ */
+#include <Arduino.h>
+#include "uRTCLibJournal.h"
+
+#ifndef URTCLIB_NO_RAM // Journal is stored on RTC RAM
+
+/**
+ * \brief Constructor
+ *
+ * @param rtc uRTCLib instance, DS1307 or DS3232
+ */
+uRTCLibJournal::uRTCLibJournal(uRTCLib &rtc) {
+	_rtc = &rtc;
+}
+
+/**
+ * \brief Checks last heartbeat against RTC time and records outage
+ *
+ * Call it once at boot, it refreshes RTC. Journal is initialized if not found.
+ *
+ * Outages of unknown duration are recorded only once while RTC lost power flag stays set.
+ *
+ * @return True if an outage was recorded
+ */
+bool uRTCLibJournal::begin() {
+	byte data[8];
+	uint32_t now;
+	uint8_t j;
+	bool recorded = false;
+
+	_valid = false;
+	_lastOutage = 0;
+	if (!_rtc->refresh() || !_rtc->ramReadBlock(URTCLIB_JOURNAL_RAM_ADDRESS, data, 7)) {
+		return false;
+	}
+	_valid = true;
+	now = _rtc->epoch();
+	if (data[0] != URTCLIB_JOURNAL_MAGIC || (data[2] & 0b01111111) >= URTCLIB_JOURNAL_ENTRIES) {
+		_outages = 0;
+		_next = 0;
+		_unknown = false;
+		_heartbeat = now;
+		_save();
+		return false;
+	}
+	_outages = data[1];
+	_next = data[2] & 0b01111111;
+	_unknown = data[2] & 0b10000000;
+	_heartbeat = 0;
+	for (j = 0; j < 4; j++) {
+		_heartbeat |= (uint32_t) data[3 + j] << (8 * j);
+	}
+
+	if (_rtc->lostPower()) {
+		_lastOutage = URTCLIB_JOURNAL_UNKNOWN;
+	} else if (now > _heartbeat) {
+		_lastOutage = now - _heartbeat;
+	}
+	// Same unknown outage seen on a previous boot: lost power flag has not been cleared since then
+	if (_lastOutage >= URTCLIB_JOURNAL_MIN_OUTAGE && _lastOutage > 0 && !(_lastOutage == URTCLIB_JOURNAL_UNKNOWN && _unknown)) {
+		for (j = 0; j < 4; j++) {
+			data[j] = _heartbeat >> (8 * j);
+			data[4 + j] = _lastOutage >> (8 * j);
+		}
+		_rtc->ramWriteBlock(URTCLIB_JOURNAL_RAM_ADDRESS + 7 + 8 * _next, data, 8);
+		_next = (_next + 1) % URTCLIB_JOURNAL_ENTRIES;
+		if (_outages < 255) {
+			_outages++;
+		}
+		recorded = true;
+	}
+	_unknown = _rtc->lostPower();
+	_heartbeat = now;
+	_save();
+	return recorded;
+}
+
+/**
+ * \brief Stores current RTC time as heartbeat
+ *
+ * Uses cached time, so call refresh() before. Writes only once each #URTCLIB_JOURNAL_PERIOD seconds
+ * or when RTC lost power flag has been cleared, a 5 bytes burst; other calls don't access I2C bus.
+ *
+ * @param force Write even if period has not elapsed, i.e. just before a controlled shutdown
+ *
+ * @return True if heartbeat was written
+ */
+bool uRTCLibJournal::heartbeat(const bool force) {
+	byte data[5];
+	uint32_t now = _rtc->epoch();
+	uint8_t j;
+	// Lost power flag cleared: next unknown outage is a new one
+	bool cleared = _unknown && !_rtc->lostPower();
+	// now < _heartbeat: clock was set backwards, write to follow it
+	if (!_valid || (!force && !cleared && now >= _heartbeat && now - _heartbeat < URTCLIB_JOURNAL_PERIOD)) {
+		return false;
+	}
+	data[0] = _next | (_unknown && !cleared ? 0b10000000 : 0);
+	for (j = 0; j < 4; j++) {
+		data[1 + j] = now >> (8 * j);
+	}
+	if (!_rtc->ramWriteBlock(URTCLIB_JOURNAL_RAM_ADDRESS + 2, data, 5)) {
+		return false;
+	}
+	_unknown = _unknown && !cleared;
+	_heartbeat = now;
+	return true;
+}
+
+/**
+ * \brief Returns downtime detected by begin()
+ *
+ * @return Seconds, 0 if none or #URTCLIB_JOURNAL_UNKNOWN
+ */
+uint32_t uRTCLibJournal::lastOutage() {
+	return _lastOutage;
+}
+
+/**
+ * \brief Returns total outages recorded
+ *
+ * @return Outages count, stops at 255
+ */
+uint8_t uRTCLibJournal::outages() {
+	return _outages;
+}
+
+/**
+ * \brief Reads an outage from history
+ *
+ * @param index 0 for most recent one
+ * @param start Outage start (last heartbeat), UNIX timestamp
+ * @param duration Outage duration in seconds or #URTCLIB_JOURNAL_UNKNOWN
+ *
+ * @return False if there's no such entry or on RAM error
+ */
+bool uRTCLibJournal::outage(const uint8_t index, uint32_t *start, uint32_t *duration) {
+	byte data[8];
+	uint8_t slot, j;
+	if (!_valid || index >= _outages || index >= URTCLIB_JOURNAL_ENTRIES) {
+		return false;
+	}
+	slot = (_next + URTCLIB_JOURNAL_ENTRIES - 1 - index) % URTCLIB_JOURNAL_ENTRIES;
+	if (!_rtc->ramReadBlock(URTCLIB_JOURNAL_RAM_ADDRESS + 7 + 8 * slot, data, 8)) {
+		return false;
+	}
+	*start = 0;
+	*duration = 0;
+	for (j = 0; j < 4; j++) {
+		*start |= (uint32_t) data[j] << (8 * j);
+		*duration |= (uint32_t) data[4 + j] << (8 * j);
+	}
+	return true;
+}
+
+/**
+ * \brief Clears outage history
+ *
+ * @return False on RAM error
+ */
+bool uRTCLibJournal::clear() {
+	if (!_valid) {
+		return false;
+	}
+	_outages = 0;
+	_next = 0;
+	return _save();
+}
+
+/**
+ * \brief Stores journal header and heartbeat on RTC RAM
+ *
+ * @return False on RAM error
+ */
+bool uRTCLibJournal::_save() {
+	byte data[7];
+	uint8_t j;
+	data[0] = URTCLIB_JOURNAL_MAGIC;
+	data[1] = _outages;
+	data[2] = _next | (_unknown ? 0b10000000 : 0);
+	for (j = 0; j < 4; j++) {
+		data[3 + j] = _heartbeat >> (8 * j);
+	}
+	return _rtc->ramWriteBlock(URTCLIB_JOURNAL_RAM_ADDRESS, data, 7);
+}
+
+#endif
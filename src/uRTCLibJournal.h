@@ -0,0 +1,157 @@
+/**
+ * \class uRTCLibJournal
+ * \brief Power-outage journal on RTC RAM for DS1307 and DS3232
+ *
+ * heartbeat() periodically stores current RTC time on RAM. On next boot begin() compares it with RTC time,
+ * so downtime duration is known (with heartbeat period resolution) and added to a small outage history.
+ *
+ * RAM layout, starting at #URTCLIB_JOURNAL_RAM_ADDRESS:
+ *	 - Byte 0: #URTCLIB_JOURNAL_MAGIC
+ *	 - Byte 1: total outages count (stops at 255)
+ *	 - Byte 2: next history slot (bits 0-6); bit 7 set while RTC keeps lost power flag after recording it
+ *	 - Bytes 3-6: last heartbeat, UNIX timestamp
+ *	 - Then #URTCLIB_JOURNAL_ENTRIES entries of 8 bytes: outage start and duration
+ *
+ * An outage of unknown duration (RTC lost power too) is recorded once, even if lost power flag stays set on next
+ * boots. Once it's cleared (uRTCLib::lostPowerClear(), after setting time) a new one can be recorded.
+ *
+ * @file uRTCLibJournal.h
+ * @copyright Naguissa
+ * @author Naguissa
+ * @see <a href="https://github.com/Naguissa/uRTCLib">https://github.com/Naguissa/uRTCLib</a>
+ * @see <a href="mailto:naguissa@foroelectro.net">naguissa@foroelectro.net</a>
+ * @version 6.9.9
+ */
+#ifndef URTCLIBJOURNAL
+	/**
+	 * \brief Prevent multiple inclussion
+	 */
+	#define URTCLIBJOURNAL
+	#include "Arduino.h"
+	#include "uRTCLib.h"
+
+	#ifndef URTCLIB_NO_RAM // Journal is stored on RTC RAM
+
+	/**
+	 * \brief Number of outages kept on history
+	 */
+	#ifndef URTCLIB_JOURNAL_ENTRIES
+		#define URTCLIB_JOURNAL_ENTRIES 4
+	#endif
+
+	/**
+	 * \brief Minimum seconds between heartbeat writes
+	 *
+	 * It's also outage duration resolution
+	 */
+	#ifndef URTCLIB_JOURNAL_PERIOD
+		#define URTCLIB_JOURNAL_PERIOD 60
+	#endif
+
+	/**
+	 * \brief Minimum downtime, in seconds, to be recorded as outage
+	 *
+	 * Shorter ones (i.e. a quick MCU reset) only update lastOutage()
+	 */
+	#ifndef URTCLIB_JOURNAL_MIN_OUTAGE
+		#define URTCLIB_JOURNAL_MIN_OUTAGE URTCLIB_JOURNAL_PERIOD
+	#endif
+
+	/**
+	 * \brief RAM address where journal is stored
+	 *
+	 * Uses 7 + 8 * #URTCLIB_JOURNAL_ENTRIES bytes; default fits DS1307 RAM. Up to 5 entries fit below monotonic
+	 * offset (#URTCLIB_MONOTONIC_RAM_ADDRESS) when URTCLIB_WITH_MONOTONIC is defined.
+	 */
+	#ifndef URTCLIB_JOURNAL_RAM_ADDRESS
+		#define URTCLIB_JOURNAL_RAM_ADDRESS 0x00
+	#endif
+
+	#if !defined(URTCLIB_NO_MONOTONIC) && URTCLIB_JOURNAL_RAM_ADDRESS < URTCLIB_MONOTONIC_RAM_ADDRESS + 5 && URTCLIB_MONOTONIC_RAM_ADDRESS < URTCLIB_JOURNAL_RAM_ADDRESS + 7 + 8 * URTCLIB_JOURNAL_ENTRIES
+		#error "uRTCLibJournal RAM area overlaps monotonic offset: reduce URTCLIB_JOURNAL_ENTRIES or move URTCLIB_JOURNAL_RAM_ADDRESS / URTCLIB_MONOTONIC_RAM_ADDRESS"
+	#endif
+
+	/**
+	 * \brief Journal identifier on RAM
+	 */
+	#define URTCLIB_JOURNAL_MAGIC 0x5A
+
+	/**
+	 * \brief Outage duration when RTC also lost power, so time is not valid
+	 */
+	#define URTCLIB_JOURNAL_UNKNOWN 0xFFFFFFFFUL
+
+
+	class uRTCLibJournal {
+		public:
+			/**
+			 * \brief Constructor
+			 *
+			 * @param rtc uRTCLib instance, DS1307 or DS3232
+			 */
+			uRTCLibJournal(uRTCLib &);
+			/**
+			 * \brief Checks last heartbeat against RTC time and records outage
+			 *
+			 * Call it once at boot, it refreshes RTC. Journal is initialized if not found.
+			 *
+			 * Outages of unknown duration are recorded only once while RTC lost power flag stays set.
+			 *
+			 * @return True if an outage was recorded
+			 */
+			bool begin();
+			/**
+			 * \brief Stores current RTC time as heartbeat
+			 *
+			 * Uses cached time, so call refresh() before. Writes only once each #URTCLIB_JOURNAL_PERIOD seconds
+			 * or when RTC lost power flag has been cleared, a 5 bytes burst; other calls don't access I2C bus.
+			 *
+			 * @param force Write even if period has not elapsed, i.e. just before a controlled shutdown
+			 *
+			 * @return True if heartbeat was written
+			 */
+			bool heartbeat(const bool = false);
+			/**
+			 * \brief Returns downtime detected by begin()
+			 *
+			 * @return Seconds, 0 if none or #URTCLIB_JOURNAL_UNKNOWN
+			 */
+			uint32_t lastOutage();
+			/**
+			 * \brief Returns total outages recorded
+			 *
+			 * @return Outages count, stops at 255
+			 */
+			uint8_t outages();
+			/**
+			 * \brief Reads an outage from history
+			 *
+			 * @param index 0 for most recent one
+			 * @param start Outage start (last heartbeat), UNIX timestamp
+			 * @param duration Outage duration in seconds or #URTCLIB_JOURNAL_UNKNOWN
+			 *
+			 * @return False if there's no such entry or on RAM error
+			 */
+			bool outage(const uint8_t, uint32_t *, uint32_t *);
+			/**
+			 * \brief Clears outage history
+			 *
+			 * @return False on RAM error
+			 */
+			bool clear();
+
+		private:
+			uRTCLib *_rtc;
+			bool _valid = false;
+			uint8_t _outages = 0;
+			uint8_t _next = 0;
+			bool _unknown = false;
+			uint32_t _heartbeat = 0;
+			uint32_t _lastOutage = 0;
+
+			bool _save();
+	};
+
+	#endif
+
+#endif
@@ -0,0 +1,201 @@
+/**
+ * \class uRTCLibManager
+ * \brief Round-robin polling and consensus time for several RTCs
+ *
+ * Owns several uRTCLib instances (different addresses, or different buses through a select callback),
+ * refreshes them with a bounded number of transactions per call and detects failed or drifting units.
+ *
+ * time() and failover only use cached data, so they don't use the I2C bus.
+ *
+ * @file uRTCLibManager.cpp
+ * @copyright Naguissa
+ * @author Naguissa
+ * @see <a href="https://github.com/Naguissa/uRTCLib">https://github.com/Naguissa/uRTCLib</a>
+ * @see <a href="mailto:naguissa@foroelectro.net">naguissa@foroelectro.net</a>
+ * @version 6.9.9
+ */
+#include <Arduino.h>
+#include "uRTCLibManager.h"
+
+/**
+ * \brief Constructor
+ */
+uRTCLibManager::uRTCLibManager() { }
+
+/**
+ * \brief Adds a RTC
+ *
+ * Lower index has higher priority when there's no majority (2 RTCs).
+ *
+ * @param rtc uRTCLib instance
+ * @param select Optional function called before accessing this RTC, i.e. to switch an I2C multiplexer
+ *
+ * @return RTC index, -1 if there's no room
+ */
+int8_t uRTCLibManager::add(uRTCLib &rtc, void (*select)()) {
+	if (_count >= URTCLIB_MANAGER_MAX) {
+		return -1;
+	}
+	_rtc[_count] = &rtc;
+	_select[_count] = select;
+	_epoch[_count] = 0;
+	_stamp[_count] = 0;
+	_fails[_count] = 0;
+	_status[_count] = URTCLIB_MANAGER_UNKNOWN;
+	return _count++;
+}
+
+/**
+ * \brief Refreshes next RTCs in round-robin order
+ *
+ * @param budget Maximum number of RTCs refreshed on this call
+ *
+ * @return Number of RTCs refreshed successfully
+ */
+uint8_t uRTCLibManager::poll(const uint8_t budget) {
+	uint8_t done = 0, i;
+	for (i = 0; i < budget && i < _count; i++) {
+		if (_select[_next] != NULL) {
+			_select[_next]();
+		}
+		if (_rtc[_next]->refresh()) {
+			_stamp[_next] = millis();
+			_epoch[_next] = _rtc[_next]->epoch();
+			_fails[_next] = 0;
+			_status[_next] = _rtc[_next]->lostPower() ? URTCLIB_MANAGER_LOST_POWER : URTCLIB_MANAGER_OK;
+			done++;
+		} else if (_fails[_next] < URTCLIB_MANAGER_FAILS && ++_fails[_next] == URTCLIB_MANAGER_FAILS) {
+			_status[_next] = URTCLIB_MANAGER_FAILED;
+		}
+		_next = (_next + 1) % _count;
+	}
+	if (i) {
+		_consensus();
+	}
+	return done;
+}
+
+/**
+ * \brief Returns consensus time
+ *
+ * Median of healthy RTCs, projected to now with millis(). No I2C access.
+ *
+ * @return UNIX timestamp, 0 if no RTC is healthy
+ */
+uint32_t uRTCLibManager::time() {
+	if (_source < 0) {
+		return 0;
+	}
+	return _projected(_source);
+}
+
+/**
+ * \brief Returns RTC used as consensus time source
+ *
+ * @return RTC index, -1 if no RTC is healthy
+ */
+int8_t uRTCLibManager::source() {
+	return _source;
+}
+
+/**
+ * \brief Returns RTC status
+ *
+ * @param index RTC index
+ *
+ * @return Status:
+ *	 - #URTCLIB_MANAGER_UNKNOWN
+ *	 - #URTCLIB_MANAGER_OK
+ *	 - #URTCLIB_MANAGER_FAILED
+ *	 - #URTCLIB_MANAGER_LOST_POWER
+ *	 - #URTCLIB_MANAGER_DRIFTING
+ */
+uint8_t uRTCLibManager::status(const uint8_t index) {
+	if (index >= _count) {
+		return URTCLIB_MANAGER_UNKNOWN;
+	}
+	return _status[index];
+}
+
+/**
+ * \brief Returns RTC deviation from consensus time
+ *
+ * @param index RTC index
+ *
+ * @return Deviation in seconds, positive when RTC is ahead
+ */
+int32_t uRTCLibManager::deviation(const uint8_t index) {
+	if (index >= _count || _source < 0) {
+		return 0;
+	}
+	return (int32_t) (_projected(index) - _projected(_source));
+}
+
+/**
+ * \brief Returns a managed RTC
+ *
+ * @param index RTC index
+ *
+ * @return uRTCLib instance, NULL if index is not valid
+ */
+uRTCLib * uRTCLibManager::rtc(const uint8_t index) {
+	if (index >= _count) {
+		return NULL;
+	}
+	return _rtc[index];
+}
+
+/**
+ * \brief Returns number of managed RTCs
+ *
+ * @return RTC count
+ */
+uint8_t uRTCLibManager::count() {
+	return _count;
+}
+
+/**
+ * \brief Projects cached RTC time to now
+ *
+ * @param index RTC index
+ *
+ * @return UNIX timestamp
+ */
+uint32_t uRTCLibManager::_projected(const uint8_t index) {
+	return _epoch[index] + (millis() - _stamp[index]) / 1000;
+}
+
+/**
+ * \brief Selects consensus source and marks drifting RTCs
+ *
+ * Median of valid RTCs; with an even number the one with lower index among middle ones.
+ */
+void uRTCLibManager::_consensus() {
+	uint8_t order[URTCLIB_MANAGER_MAX], n = 0, i, j, tmp;
+	uint32_t consensus;
+	int32_t diff;
+	for (i = 0; i < _count; i++) {
+		if (_status[i] == URTCLIB_MANAGER_OK || _status[i] == URTCLIB_MANAGER_DRIFTING) {
+			// Insertion sort by projected time
+			for (j = n; j > 0 && _projected(order[j - 1]) > _projected(i); j--) {
+				order[j] = order[j - 1];
+			}
+			order[j] = i;
+			n++;
+		}
+	}
+	if (n == 0) {
+		_source = -1;
+		return;
+	}
+	tmp = order[(n - 1) / 2];
+	if (!(n & 1) && order[n / 2] < tmp) {
+		tmp = order[n / 2];
+	}
+	_source = tmp;
+	consensus = _projected(_source);
+	for (i = 0; i < n; i++) {
+		diff = (int32_t) (_projected(order[i]) - consensus);
+		_status[order[i]] = (diff > URTCLIB_MANAGER_TOLERANCE || diff < -URTCLIB_MANAGER_TOLERANCE) ? URTCLIB_MANAGER_DRIFTING : URTCLIB_MANAGER_OK;
+	}
+}
@@ -0,0 +1,164 @@
+/**
+ * \class uRTCLibManager
+ * \brief Round-robin polling and consensus time for several RTCs
+ *
+ * Owns several uRTCLib instances (different addresses, or different buses through a select callback),
+ * refreshes them with a bounded number of transactions per call and detects failed or drifting units.
+ *
+ * time() and failover only use cached data, so they don't use the I2C bus.
+ *
+ * @file uRTCLibManager.h
+ * @copyright Naguissa
+ * @author Naguissa
+ * @see <a href="https://github.com/Naguissa/uRTCLib">https://github.com/Naguissa/uRTCLib</a>
+ * @see <a href="mailto:naguissa@foroelectro.net">naguissa@foroelectro.net</a>
+ * @version 6.9.9
+ */
+#ifndef URTCLIBMANAGER
+	/**
+	 * \brief Prevent multiple inclussion
+	 */
+	#define URTCLIBMANAGER
+	#include "Arduino.h"
+	#include "uRTCLib.h"
+
+	/**
+	 * \brief Maximum number of managed RTCs
+	 */
+	#ifndef URTCLIB_MANAGER_MAX
+		#define URTCLIB_MANAGER_MAX 4
+	#endif
+
+	/**
+	 * \brief Maximum deviation from consensus time, in seconds, before marking an RTC as drifting
+	 */
+	#ifndef URTCLIB_MANAGER_TOLERANCE
+		#define URTCLIB_MANAGER_TOLERANCE 2
+	#endif
+
+	/**
+	 * \brief Consecutive refresh errors before marking an RTC as failed
+	 */
+	#ifndef URTCLIB_MANAGER_FAILS
+		#define URTCLIB_MANAGER_FAILS 3
+	#endif
+
+
+	/************	RTC STATUS ***********/
+	/**
+	 * \brief RTC status - Not refreshed yet
+	 */
+	#define URTCLIB_MANAGER_UNKNOWN 0
+
+	/**
+	 * \brief RTC status - OK
+	 */
+	#define URTCLIB_MANAGER_OK 1
+
+	/**
+	 * \brief RTC status - Too many consecutive refresh errors
+	 */
+	#define URTCLIB_MANAGER_FAILED 2
+
+	/**
+	 * \brief RTC status - Lost power flag set, time not valid
+	 */
+	#define URTCLIB_MANAGER_LOST_POWER 3
+
+	/**
+	 * \brief RTC status - Deviation from consensus bigger than #URTCLIB_MANAGER_TOLERANCE
+	 */
+	#define URTCLIB_MANAGER_DRIFTING 4
+
+
+	class uRTCLibManager {
+		public:
+			/**
+			 * \brief Constructor
+			 */
+			uRTCLibManager();
+			/**
+			 * \brief Adds a RTC
+			 *
+			 * Lower index has higher priority when there's no majority (2 RTCs).
+			 *
+			 * @param rtc uRTCLib instance
+			 * @param select Optional function called before accessing this RTC, i.e. to switch an I2C multiplexer
+			 *
+			 * @return RTC index, -1 if there's no room
+			 */
+			int8_t add(uRTCLib &, void (*)() = NULL);
+			/**
+			 * \brief Refreshes next RTCs in round-robin order
+			 *
+			 * @param budget Maximum number of RTCs refreshed on this call
+			 *
+			 * @return Number of RTCs refreshed successfully
+			 */
+			uint8_t poll(const uint8_t = 1);
+			/**
+			 * \brief Returns consensus time
+			 *
+			 * Median of healthy RTCs, projected to now with millis(). No I2C access.
+			 *
+			 * @return UNIX timestamp, 0 if no RTC is healthy
+			 */
+			uint32_t time();
+			/**
+			 * \brief Returns RTC used as consensus time source
+			 *
+			 * @return RTC index, -1 if no RTC is healthy
+			 */
+			int8_t source();
+			/**
+			 * \brief Returns RTC status
+			 *
+			 * @param index RTC index
+			 *
+			 * @return Status:
+			 *	 - #URTCLIB_MANAGER_UNKNOWN
+			 *	 - #URTCLIB_MANAGER_OK
+			 *	 - #URTCLIB_MANAGER_FAILED
+			 *	 - #URTCLIB_MANAGER_LOST_POWER
+			 *	 - #URTCLIB_MANAGER_DRIFTING
+			 */
+			uint8_t status(const uint8_t);
+			/**
+			 * \brief Returns RTC deviation from consensus time
+			 *
+			 * @param index RTC index
+			 *
+			 * @return Deviation in seconds, positive when RTC is ahead
+			 */
+			int32_t deviation(const uint8_t);
+			/**
+			 * \brief Returns a managed RTC
+			 *
+			 * @param index RTC index
+			 *
+			 * @return uRTCLib instance, NULL if index is not valid
+			 */
+			uRTCLib * rtc(const uint8_t);
+			/**
+			 * \brief Returns number of managed RTCs
+			 *
+			 * @return RTC count
+			 */
+			uint8_t count();
+
+		private:
+			uRTCLib * _rtc[URTCLIB_MANAGER_MAX];
+			void (*_select[URTCLIB_MANAGER_MAX])();
+			uint32_t _epoch[URTCLIB_MANAGER_MAX];
+			unsigned long _stamp[URTCLIB_MANAGER_MAX];
+			uint8_t _fails[URTCLIB_MANAGER_MAX];
+			uint8_t _status[URTCLIB_MANAGER_MAX];
+			uint8_t _count = 0;
+			uint8_t _next = 0;
+			int8_t _source = -1;
+
+			uint32_t _projected(const uint8_t);
+			void _consensus();
+	};
+
+#endif
@@ -0,0 +1,223 @@
+/**
+ * \class uRTCLibOscCal
+ * \brief MCU oscillator calibration using RTC square wave output
+ *
+ * Measures MCU clock (micros()) against a number of SQW (or 32K) output periods, giving MCU clock error in ppm and a
+ * correction factor for millis() based code. On AVR with internal RC oscillator it can also trim OSCCAL register.
+ *
+ * @file uRTCLibOscCal.cpp
+ * @copyright Naguissa
+ * @author Naguissa
+ * @see <a href="https://github.com/Naguissa/uRTCLib">https://github.com/Naguissa/uRTCLib</a>
+ * @see <a href="mailto:naguissa@foroelectro.net">naguissa@foroelectro.net</a>
+ * @version 6.9.9
+ */
+#include <Arduino.h>
+#include "uRTCLibOscCal.h"
+
+#ifndef URTCLIB_NO_SQWG // Needs RTC square wave output
+
+/**
+ * \brief Constructor
+ *
+ * @param rtc uRTCLib instance
+ * @param pin MCU pin connected to RTC SQW (or 32K) pin
+ */
+uRTCLibOscCal::uRTCLibOscCal(uRTCLib &rtc, const uint8_t pin) {
+	_rtc = &rtc;
+	_pin = pin;
+}
+
+/**
+ * \brief Starts RTC output used as reference
+ *
+ * #URTCLIB_SQWG_32768H uses 32K pin on DS3231/DS3232 (enable32KOut()), SQW pin on DS1307. Other modes use SQW pin.
+ * Use a slow output on MCUs that can't poll pin fast enough. On DS3231/DS3232 SQWG disables alarm interrupts.
+ *
+ * @param mode RTC output:
+ *	 - #URTCLIB_SQWG_1H
+ *	 - #URTCLIB_SQWG_1024H
+ *	 - #URTCLIB_SQWG_4096H
+ *	 - #URTCLIB_SQWG_8192H
+ *	 - #URTCLIB_SQWG_32768H
+ *
+ * @return false in case of not supported mode or error
+ */
+bool uRTCLibOscCal::begin(const uint8_t mode) {
+	bool ret;
+	switch (mode) {
+		case URTCLIB_SQWG_1H:
+			_frequency = 1;
+			break;
+
+		case URTCLIB_SQWG_1024H:
+			_frequency = 1024;
+			break;
+
+		case URTCLIB_SQWG_4096H:
+			_frequency = 4096;
+			break;
+
+		case URTCLIB_SQWG_8192H:
+			_frequency = 8192;
+			break;
+
+		case URTCLIB_SQWG_32768H:
+			_frequency = 32768;
+			break;
+
+		default:
+			_frequency = 0;
+			return false;
+	}
+	pinMode(_pin, INPUT_PULLUP); // SQW and 32K are open drain
+	#ifdef URTCLIB_NO_32K
+	ret = _rtc->sqwgSetMode(mode);
+	#else
+	ret = mode == URTCLIB_SQWG_32768H ? _rtc->enable32KOut() : _rtc->sqwgSetMode(mode);
+	#endif
+	if (!ret) {
+		_frequency = 0;
+		return false;
+	}
+	_mode = mode;
+	return true;
+}
+
+/**
+ * \brief Stops RTC output started by begin()
+ */
+void uRTCLibOscCal::end() {
+	if (_frequency == 0) {
+		return;
+	}
+	#ifndef URTCLIB_NO_32K
+	if (_mode == URTCLIB_SQWG_32768H) {
+		_rtc->disable32KOut();
+		_frequency = 0;
+		return;
+	}
+	#endif
+	_rtc->sqwgSetMode(URTCLIB_SQWG_OFF_1);
+	_frequency = 0;
+}
+
+/**
+ * \brief Measures MCU clock error
+ *
+ * Blocks for edges + 1 output periods at most, twice that before giving up.
+ *
+ * @param edges Number of output periods to measure
+ *
+ * @return MCU clock error in ppm, positive when MCU runs fast. #URTCLIB_OSCCAL_ERROR if edges are not seen.
+ */
+long uRTCLibOscCal::measure(const uint16_t edges) {
+	unsigned long started = micros(), limit, first = 0, now;
+	float expected;
+	uint16_t count = 0;
+	int previous, current;
+	if (_frequency == 0 || edges == 0) {
+		return URTCLIB_OSCCAL_ERROR;
+	}
+	expected = 1000000.0 * edges / _frequency;
+	limit = (unsigned long) (2 * (expected + 1000000.0 / _frequency));
+	previous = digitalRead(_pin);
+	while (micros() - started < limit) {
+		current = digitalRead(_pin);
+		if (previous == HIGH && current == LOW) {
+			now = micros();
+			if (count == 0) {
+				first = now;
+			} else if (count == edges) {
+				_ppm = (long) (((now - first) - expected) * 1000000.0 / expected);
+				return _ppm;
+			}
+			count++;
+			if (_frequency == 1) { // Plenty of time until next edge
+				uRTCLIB_YIELD_WAIT
+			}
+		}
+		previous = current;
+	}
+	return URTCLIB_OSCCAL_ERROR;
+}
+
+/**
+ * \brief Returns last measured MCU clock error
+ *
+ * @return MCU clock error in ppm, positive when MCU runs fast
+ */
+long uRTCLibOscCal::ppm() {
+	return _ppm;
+}
+
+/**
+ * \brief Returns correction factor for MCU time intervals
+ *
+ * @return Real time / MCU time ratio
+ */
+float uRTCLibOscCal::factor() {
+	return 1000000.0 / (1000000.0 + _ppm);
+}
+
+/**
+ * \brief Corrects a MCU time interval
+ *
+ * @param interval Interval measured with millis() or micros()
+ *
+ * @return Real interval, same units
+ */
+unsigned long uRTCLibOscCal::correct(const unsigned long interval) {
+	return (unsigned long) (interval * factor() + 0.5);
+}
+
+/**
+ * \brief Trims AVR internal RC oscillator (OSCCAL register)
+ *
+ * Steps OSCCAL and measures 1 period each time until error changes sign. Use 1Hz output; it can take up to
+ * #URTCLIB_OSCCAL_TRIM_STEPS * 2 seconds. Serial baud rate changes with MCU clock.
+ *
+ * @return False if MCU has no OSCCAL, it doesn't affect MCU clock (i.e. external crystal) or on error
+ */
+bool uRTCLibOscCal::trim() {
+	#ifdef OSCCAL
+		long error = measure(1), last, best;
+		uint8_t bestCal = OSCCAL, i;
+		int8_t step;
+		if (error == URTCLIB_OSCCAL_ERROR) {
+			return false;
+		}
+		best = error;
+		step = error > 0 ? -1 : 1; // Positive error: MCU fast, lower OSCCAL
+		for (i = 0; i < URTCLIB_OSCCAL_TRIM_STEPS; i++) {
+			if ((step < 0 && OSCCAL == 0x00) || (step > 0 && OSCCAL == 0xFF)) {
+				break;
+			}
+			OSCCAL += step;
+			last = error;
+			error = measure(1);
+			if (error == URTCLIB_OSCCAL_ERROR) {
+				break;
+			}
+			if (error - last < 100 && last - error < 100) { // No effect, MCU is not running on internal RC
+				OSCCAL = bestCal;
+				_ppm = best;
+				return false;
+			}
+			if ((error < 0 ? -error : error) < (best < 0 ? -best : best)) {
+				best = error;
+				bestCal = OSCCAL;
+			}
+			if ((error > 0) != (last > 0)) { // Crossed 0
+				break;
+			}
+		}
+		OSCCAL = bestCal;
+		_ppm = best;
+		return true;
+	#else
+		return false;
+	#endif
+}
+
+#endif
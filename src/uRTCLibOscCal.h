@@ -0,0 +1,128 @@
+/**
+ * \class uRTCLibOscCal
+ * \brief MCU oscillator calibration using RTC square wave output
+ *
+ * Measures MCU clock (micros()) against a number of SQW (or 32K) output periods, giving MCU clock error in ppm and a
+ * correction factor for millis() based code. On AVR with internal RC oscillator it can also trim OSCCAL register.
+ *
+ * Pin is polled, no interrupt is used. Falling edges are timed, so 1Hz output on DS3231/DS3232 matches seconds update.
+ *
+ * @file uRTCLibOscCal.h
+ * @copyright Naguissa
+ * @author Naguissa
+ * @see <a href="https://github.com/Naguissa/uRTCLib">https://github.com/Naguissa/uRTCLib</a>
+ * @see <a href="mailto:naguissa@foroelectro.net">naguissa@foroelectro.net</a>
+ * @version 6.9.9
+ */
+#ifndef URTCLIBOSCCAL
+	/**
+	 * \brief Prevent multiple inclussion
+	 */
+	#define URTCLIBOSCCAL
+	#include "Arduino.h"
+	#include "uRTCLib.h"
+
+	#ifndef URTCLIB_NO_SQWG // Needs RTC square wave output
+
+	/**
+	 * \brief Default number of output periods measured by measure()
+	 *
+	 * 4 seconds at 1Hz, that's about 1ppm resolution with 4us micros() resolution
+	 */
+	#ifndef URTCLIB_OSCCAL_EDGES
+		#define URTCLIB_OSCCAL_EDGES 4
+	#endif
+
+	/**
+	 * \brief Maximum OSCCAL changes tried by trim()
+	 */
+	#ifndef URTCLIB_OSCCAL_TRIM_STEPS
+		#define URTCLIB_OSCCAL_TRIM_STEPS 32
+	#endif
+
+	/**
+	 * \brief Error value returned by measure() when no edges are seen
+	 */
+	#define URTCLIB_OSCCAL_ERROR 2147483647L
+
+
+	class uRTCLibOscCal {
+		public:
+			/**
+			 * \brief Constructor
+			 *
+			 * @param rtc uRTCLib instance
+			 * @param pin MCU pin connected to RTC SQW (or 32K) pin
+			 */
+			uRTCLibOscCal(uRTCLib &, const uint8_t);
+			/**
+			 * \brief Starts RTC output used as reference
+			 *
+			 * #URTCLIB_SQWG_32768H uses 32K pin on DS3231/DS3232 (enable32KOut()), SQW pin on DS1307. Other modes use SQW pin.
+			 * Use a slow output on MCUs that can't poll pin fast enough. On DS3231/DS3232 SQWG disables alarm interrupts.
+			 *
+			 * @param mode RTC output:
+			 *	 - #URTCLIB_SQWG_1H
+			 *	 - #URTCLIB_SQWG_1024H
+			 *	 - #URTCLIB_SQWG_4096H
+			 *	 - #URTCLIB_SQWG_8192H
+			 *	 - #URTCLIB_SQWG_32768H
+			 *
+			 * @return false in case of not supported mode or error
+			 */
+			bool begin(const uint8_t = URTCLIB_SQWG_1H);
+			/**
+			 * \brief Stops RTC output started by begin()
+			 */
+			void end();
+			/**
+			 * \brief Measures MCU clock error
+			 *
+			 * Blocks for edges + 1 output periods at most, twice that before giving up.
+			 *
+			 * @param edges Number of output periods to measure
+			 *
+			 * @return MCU clock error in ppm, positive when MCU runs fast. #URTCLIB_OSCCAL_ERROR if edges are not seen.
+			 */
+			long measure(const uint16_t = URTCLIB_OSCCAL_EDGES);
+			/**
+			 * \brief Returns last measured MCU clock error
+			 *
+			 * @return MCU clock error in ppm, positive when MCU runs fast
+			 */
+			long ppm();
+			/**
+			 * \brief Returns correction factor for MCU time intervals
+			 *
+			 * @return Real time / MCU time ratio
+			 */
+			float factor();
+			/**
+			 * \brief Corrects a MCU time interval
+			 *
+			 * @param interval Interval measured with millis() or micros()
+			 *
+			 * @return Real interval, same units
+			 */
+			unsigned long correct(const unsigned long);
+			/**
+			 * \brief Trims AVR internal RC oscillator (OSCCAL register)
+			 *
+			 * Steps OSCCAL and measures 1 period each time until error changes sign. Use 1Hz output; it can take up to
+			 * #URTCLIB_OSCCAL_TRIM_STEPS * 2 seconds. Serial baud rate changes with MCU clock.
+			 *
+			 * @return False if MCU has no OSCCAL, it doesn't affect MCU clock (i.e. external crystal) or on error
+			 */
+			bool trim();
+
+		private:
+			uRTCLib *_rtc;
+			uint8_t _pin;
+			uint8_t _mode = URTCLIB_SQWG_OFF_1;
+			uint16_t _frequency = 0;
+			long _ppm = 0;
+	};
+
+	#endif
+
+#endif
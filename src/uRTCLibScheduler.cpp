@@ -0,0 +1,181 @@
+/**
+ * \class uRTCLibScheduler
+ * \brief Cooperative time-triggered task scheduler using RTC as timebase
+ *
+ * Runs tasks from a static table every N seconds, daily at a time or weekly on a day and time. Next run of each
+ * task is computed from RTC time and earliest deadline is kept, so run() only compares it with a millis()
+ * projection of RTC time. RTC is read once per executed deadline.
+ *
+ * @file uRTCLibScheduler.cpp
+ * @copyright Naguissa
+ * @author Naguissa
+ * @see <a href="https://github.com/Naguissa/uRTCLib">https://github.com/Naguissa/uRTCLib</a>
+ * @see <a href="mailto:naguissa@foroelectro.net">naguissa@foroelectro.net</a>
+ * @version 6.9.9
+ */
+#include <Arduino.h>
+#include "uRTCLibScheduler.h"
+
+/**
+ * \brief Constructor
+ *
+ * @param rtc uRTCLib instance
+ * @param tasks Task table, it's not copied so it must stay valid
+ * @param count Number of tasks
+ */
+uRTCLibScheduler::uRTCLibScheduler(uRTCLib &rtc, uRTCLibTask *tasks, const uint8_t count) {
+	_rtc = &rtc;
+	_tasks = tasks;
+	_count = count;
+}
+
+/**
+ * \brief Reads RTC and computes next run of all tasks
+ *
+ * Call it at start and after changing RTC time or task table.
+ *
+ * @return False on RTC error
+ */
+bool uRTCLibScheduler::begin() {
+	uint8_t i;
+	if (!_sync()) {
+		return false;
+	}
+	for (i = 0; i < _count; i++) {
+		_tasks[i].next = 0;
+		_schedule(&_tasks[i], _base);
+	}
+	_findEarliest();
+	return true;
+}
+
+/**
+ * \brief Runs due tasks
+ *
+ * Call it from main loop. Without due tasks it doesn't access I2C bus.
+ *
+ * @return Milliseconds until next deadline, to sleep or yield meanwhile. #URTCLIB_SCHEDULER_IDLE if there are no tasks.
+ */
+unsigned long uRTCLibScheduler::run() {
+	unsigned long elapsed;
+	uint8_t i;
+	if (_earliest < 0) {
+		return URTCLIB_SCHEDULER_IDLE;
+	}
+	if (now() >= _tasks[_earliest].next) {
+		if (!_sync()) {
+			return 0; // Retry on next call
+		}
+		// MCU clock may run fast, so check real time
+		if (_base >= _tasks[_earliest].next) {
+			for (i = 0; i < _count; i++) {
+				if (_base >= _tasks[i].next) {
+					_schedule(&_tasks[i], _base);
+					if (_tasks[i].callback != NULL) {
+						_tasks[i].callback();
+					}
+				}
+			}
+			_findEarliest();
+		}
+	}
+	if (_tasks[_earliest].next == URTCLIB_SCHEDULER_IDLE) {
+		return URTCLIB_SCHEDULER_IDLE;
+	}
+	elapsed = millis() - _stamp;
+	if ((_tasks[_earliest].next - _base) * 1000UL <= elapsed) {
+		return 0;
+	}
+	return (_tasks[_earliest].next - _base) * 1000UL - elapsed;
+}
+
+/**
+ * \brief Returns RTC time projected with millis() since last RTC read
+ *
+ * @return UNIX timestamp, never ahead of RTC
+ */
+uint32_t uRTCLibScheduler::now() {
+	return _base + (millis() - _stamp) / 1000;
+}
+
+/**
+ * \brief Returns task with earliest deadline
+ *
+ * @return Task index, -1 if there are no tasks
+ */
+int8_t uRTCLibScheduler::earliest() {
+	return _earliest;
+}
+
+/**
+ * \brief Reads RTC time and restarts millis() projection
+ *
+ * Projection starts at read time, as if RTC second had just started, so it's never ahead of RTC.
+ *
+ * @return False on RTC error
+ */
+bool uRTCLibScheduler::_sync() {
+	if (!_rtc->refresh()) {
+		return false;
+	}
+	_stamp = millis();
+	_base = _rtc->epoch();
+	return true;
+}
+
+/**
+ * \brief Computes next run of a task after given time
+ *
+ * Periodic tasks keep their schedule, skipping missed runs.
+ *
+ * @param task Task
+ * @param current RTC time, UNIX timestamp
+ */
+void uRTCLibScheduler::_schedule(uRTCLibTask *task, const uint32_t current) {
+	uint32_t midnight = current - current % 86400UL, next;
+	uint8_t today;
+	switch (task->type) {
+		case URTCLIB_TASK_EVERY:
+			if (task->at == 0) { // Avoid an endless loop
+				next = URTCLIB_SCHEDULER_IDLE;
+			} else if (task->next == 0) {
+				next = current + task->at;
+			} else {
+				next = task->next + ((current - task->next) / task->at + 1) * task->at;
+			}
+			break;
+
+		case URTCLIB_TASK_DAILY:
+			next = midnight + task->at;
+			if (next <= current) {
+				next += 86400UL;
+			}
+			break;
+
+		case URTCLIB_TASK_WEEKLY:
+			today = ((current / 86400UL + 4) % 7) + 1; // 1970-01-01 was Thursday; 1 = Sunday
+			next = midnight + ((task->dow + 7 - today) % 7) * 86400UL + task->at;
+			if (next <= current) {
+				next += 7 * 86400UL;
+			}
+			break;
+
+		default:
+			next = URTCLIB_SCHEDULER_IDLE;
+			break;
+	}
+	task->next = next;
+}
+
+/**
+ * \brief Finds task with earliest deadline
+ */
+void uRTCLibScheduler::_findEarliest() {
+	uint8_t i;
+	_earliest = -1;
+	for (i = 0; i < _count; i++) {
+		if (_earliest < 0 || _tasks[i].next < _tasks[_earliest].next) {
+			_earliest = i;
+		}
+	}
+}
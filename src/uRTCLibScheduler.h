@@ -0,0 +1,138 @@
+/**
+ * \class uRTCLibScheduler
+ * \brief Cooperative time-triggered task scheduler using RTC as timebase
+ *
+ * Runs tasks from a static table every N seconds, daily at a time or weekly on a day and time. Next run of each
+ * task is computed from RTC time and earliest deadline is kept, so run() only compares it with a millis()
+ * projection of RTC time. RTC is read once per executed deadline.
+ *
+ * Tasks can run up to 1 second late, as RTC second phase is unknown.
+ *
+ * @file uRTCLibScheduler.h
+ * @copyright Naguissa
+ * @author Naguissa
+ * @see <a href="https://github.com/Naguissa/uRTCLib">https://github.com/Naguissa/uRTCLib</a>
+ * @see <a href="mailto:naguissa@foroelectro.net">naguissa@foroelectro.net</a>
+ * @version 6.9.9
+ */
+#ifndef URTCLIBSCHEDULER
+	/**
+	 * \brief Prevent multiple inclussion
+	 */
+	#define URTCLIBSCHEDULER
+	#include "Arduino.h"
+	#include "uRTCLib.h"
+
+
+	/************	TASK TYPES ***********/
+	/**
+	 * \brief Task type - Every uRTCLibTask::at seconds
+	 */
+	#define URTCLIB_TASK_EVERY 0
+
+	/**
+	 * \brief Task type - Daily, uRTCLibTask::at seconds after midnight
+	 */
+	#define URTCLIB_TASK_DAILY 1
+
+	/**
+	 * \brief Task type - Weekly on uRTCLibTask::dow, uRTCLibTask::at seconds after midnight
+	 */
+	#define URTCLIB_TASK_WEEKLY 2
+
+	/**
+	 * \brief Time of day, for uRTCLibTask::at
+	 */
+	#define URTCLIB_TASK_AT(hour, minute, second) ((hour) * 3600UL + (minute) * 60UL + (second))
+
+	/**
+	 * \brief run() return value when there are no tasks
+	 */
+	#define URTCLIB_SCHEDULER_IDLE 0xFFFFFFFFUL
+
+
+	/**
+	 * \brief Scheduler task
+	 *
+	 * Example: { backup, #URTCLIB_TASK_WEEKLY, URTCLIB_TASK_AT(2, 0, 0), #URTCLIB_WEEKDAY_MONDAY }
+	 */
+	struct uRTCLibTask {
+		/**
+		 * \brief Function to run
+		 */
+		void (*callback)();
+		/**
+		 * \brief Task type:
+		 *	 - #URTCLIB_TASK_EVERY
+		 *	 - #URTCLIB_TASK_DAILY
+		 *	 - #URTCLIB_TASK_WEEKLY
+		 */
+		uint8_t type;
+		/**
+		 * \brief Period in seconds (#URTCLIB_TASK_EVERY) or time of day, see URTCLIB_TASK_AT()
+		 */
+		uint32_t at;
+		/**
+		 * \brief Day of week for #URTCLIB_TASK_WEEKLY, see #URTCLIB_WEEKDAY_SUNDAY
+		 */
+		uint8_t dow;
+		/**
+		 * \brief Next run, RTC time as UNIX timestamp. Managed by scheduler.
+		 */
+		uint32_t next;
+	};
+
+
+	class uRTCLibScheduler {
+		public:
+			/**
+			 * \brief Constructor
+			 *
+			 * @param rtc uRTCLib instance
+			 * @param tasks Task table, it's not copied so it must stay valid
+			 * @param count Number of tasks
+			 */
+			uRTCLibScheduler(uRTCLib &, uRTCLibTask *, const uint8_t);
+			/**
+			 * \brief Reads RTC and computes next run of all tasks
+			 *
+			 * Call it at start and after changing RTC time or task table.
+			 *
+			 * @return False on RTC error
+			 */
+			bool begin();
+			/**
+			 * \brief Runs due tasks
+			 *
+			 * Call it from main loop. Without due tasks it doesn't access I2C bus.
+			 *
+			 * @return Milliseconds until next deadline, to sleep or yield meanwhile. #URTCLIB_SCHEDULER_IDLE if there are no tasks.
+			 */
+			unsigned long run();
+			/**
+			 * \brief Returns RTC time projected with millis() since last RTC read
+			 *
+			 * @return UNIX timestamp, never ahead of RTC
+			 */
+			uint32_t now();
+			/**
+			 * \brief Returns task with earliest deadline
+			 *
+			 * @return Task index, -1 if there are no tasks
+			 */
+			int8_t earliest();
+
+		private:
+			uRTCLib *_rtc;
+			uRTCLibTask *_tasks;
+			uint8_t _count;
+			int8_t _earliest = -1;
+			uint32_t _base = 0;
+			unsigned long _stamp = 0;
+
+			bool _sync();
+			void _schedule(uRTCLibTask *, const uint32_t);
+			void _findEarliest();
+	};
+
+#endif
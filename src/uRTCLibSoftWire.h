@@ -0,0 +1,399 @@
+/**
+ * \class uRTCLibSoftWire
+ * \brief Software (bit-banged) I2C master on any pair of pins, Wire compatible
+ *
+ * For RTCs wired to pins without hardware I2C. Pins are template parameters; lines are driven as open drain
+ * (output low or input) with port registers when the core provides them, digitalWrite()/pinMode() otherwise.
+ * External pull-ups are required.
+ *
+ * Timing follows I2C minimums for selected clock (tLOW / tHIGH: 4.7us / 4.0us up to 100 kHz, 1.3us / 0.6us
+ * above), rounded up to whole microseconds, so real clock never exceeds selected one. Slaves may stretch SCL
+ * up to #URTCLIB_SOFTWIRE_STRETCH_US.
+ *
+ * To use it as uRTCLib transport define URTCLIB_SOFTWIRE_SDA and URTCLIB_SOFTWIRE_SCL as global build flags
+ * (i.e. -DURTCLIB_SOFTWIRE_SDA=4 -DURTCLIB_SOFTWIRE_SCL=5): URTCLIB_WIRE becomes uRTCLibSoftWireBus.
+ *
+ * Port registers are changed with read-modify-write: don't change other pins of same ports from interrupts.
+ *
+ * @file uRTCLibSoftWire.h
+ * @copyright Naguissa
+ * @author Naguissa
+ * @see <a href="https://github.com/Naguissa/uRTCLib">https://github.com/Naguissa/uRTCLib</a>
+ * @see <a href="mailto:naguissa@foroelectro.net">naguissa@foroelectro.net</a>
+ * @version 6.9.9
+ */
+#ifndef URTCLIBSOFTWIRE
+	/**
+	 * \brief Prevent multiple inclussion
+	 */
+	#define URTCLIBSOFTWIRE
+	#include "Arduino.h"
+
+	/**
+	 * \brief Bytes per transaction, as Wire on most cores
+	 */
+	#ifndef URTCLIB_SOFTWIRE_BUFFER
+		#define URTCLIB_SOFTWIRE_BUFFER 32
+	#endif
+
+	/**
+	 * \brief Maximum time a slave can hold SCL low (clock stretching), in microseconds
+	 */
+	#ifndef URTCLIB_SOFTWIRE_STRETCH_US
+		#define URTCLIB_SOFTWIRE_STRETCH_US 1000
+	#endif
+
+	/**
+	 * \brief Slowest bus clock, in Hz; setClock() raises lower values (and 0) to it
+	 */
+	#define URTCLIB_SOFTWIRE_MIN_CLOCK 1000UL
+
+	#if defined(portOutputRegister) && defined(portInputRegister) && defined(portModeRegister)
+		/**
+		 * \brief Port registers are available
+		 */
+		#define URTCLIB_SOFTWIRE_PORTS
+		#ifdef __AVR__
+			/**
+			 * \brief Port register type
+			 */
+			typedef uint8_t uRTCLibSoftWireReg;
+		#else
+			typedef uint32_t uRTCLibSoftWireReg;
+		#endif
+	#endif
+
+
+	template <uint8_t SDA_PIN, uint8_t SCL_PIN>
+	class uRTCLibSoftWire {
+		public:
+			/**
+			 * \brief Releases both lines and selects 100 kHz
+			 */
+			void begin() {
+				#ifdef URTCLIB_SOFTWIRE_PORTS
+				uint8_t port = digitalPinToPort(SDA_PIN);
+				_sdaMask = digitalPinToBitMask(SDA_PIN);
+				_sdaMode = portModeRegister(port);
+				_sdaIn = portInputRegister(port);
+				port = digitalPinToPort(SCL_PIN);
+				_sclMask = digitalPinToBitMask(SCL_PIN);
+				_sclMode = portModeRegister(port);
+				_sclIn = portInputRegister(port);
+				#endif
+				// Output latch stays low, lines are driven switching mode only
+				pinMode(SDA_PIN, INPUT);
+				pinMode(SCL_PIN, INPUT);
+				digitalWrite(SDA_PIN, LOW);
+				digitalWrite(SCL_PIN, LOW);
+				setClock(100000UL);
+			}
+
+			/**
+			 * \brief Sets bus clock
+			 *
+			 * @param clock Clock in Hz, #URTCLIB_SOFTWIRE_MIN_CLOCK if lower
+			 */
+			void setClock(const uint32_t clock) {
+				uint32_t hz = clock < URTCLIB_SOFTWIRE_MIN_CLOCK ? URTCLIB_SOFTWIRE_MIN_CLOCK : clock;
+				uint16_t period = (1000000UL + hz - 1) / hz;
+				// Bus timing minimums, rounded up
+				_low = hz > 100000UL ? 2 : 5;
+				_high = hz > 100000UL ? 1 : 4;
+				if (_low < (period + 1) / 2) {
+					_low = (period + 1) / 2;
+				}
+				if (_high < period - _low) {
+					_high = period - _low;
+				}
+			}
+
+			/**
+			 * \brief Starts a write transaction
+			 *
+			 * @param address 7 bit slave address
+			 */
+			void beginTransmission(const int address) {
+				_address = address;
+				_txLength = 0;
+				_overflow = false;
+			}
+
+			/**
+			 * \brief Queues a byte
+			 *
+			 * @param data Byte to send
+			 *
+			 * @return 1, 0 if buffer is full
+			 */
+			size_t write(const uint8_t data) {
+				if (_txLength >= URTCLIB_SOFTWIRE_BUFFER) {
+					_overflow = true;
+					return 0;
+				}
+				_buffer[_txLength++] = data;
+				return 1;
+			}
+
+			/**
+			 * \brief Queues several bytes
+			 *
+			 * @param data Bytes to send
+			 * @param length Number of bytes
+			 *
+			 * @return Bytes queued
+			 */
+			size_t write(const uint8_t *data, const size_t length) {
+				size_t i;
+				for (i = 0; i < length && write(data[i]); i++) { }
+				return i;
+			}
+
+			/**
+			 * \brief Sends queued transaction
+			 *
+			 * @param stop Send stop condition; if false next transaction starts with a repeated start
+			 *
+			 * @return As Wire: 0 success, 1 data too long, 2 address NACK, 3 data NACK, 4 other error (bus stuck)
+			 */
+			uint8_t endTransmission(const bool stop = true) {
+				uint8_t i, ret = 0;
+				if (_overflow) { // Nothing was sent, bus is left untouched
+					_txLength = 0;
+					return 1;
+				}
+				if (!_start()) {
+					return 4;
+				} else if (!_writeByte(_address << 1)) {
+					ret = _stuck ? 4 : 2;
+				} else {
+					for (i = 0; i < _txLength; i++) {
+						if (!_writeByte(_buffer[i])) {
+							ret = _stuck ? 4 : 3;
+							break;
+						}
+					}
+				}
+				if ((stop || ret) && !_stop()) {
+					ret = 4;
+				}
+				_txLength = 0;
+				return ret;
+			}
+
+			/**
+			 * \brief Reads bytes from a slave
+			 *
+			 * @param address 7 bit slave address
+			 * @param quantity Bytes to read, up to #URTCLIB_SOFTWIRE_BUFFER
+			 * @param stop Send stop condition
+			 *
+			 * @return Bytes received, 0 on error
+			 */
+			uint8_t requestFrom(const int address, const int quantity, const bool stop = true) {
+				uint8_t length = quantity > URTCLIB_SOFTWIRE_BUFFER ? URTCLIB_SOFTWIRE_BUFFER : quantity;
+				_rxLength = 0;
+				_rxIndex = 0;
+				if (length == 0 || !_start()) {
+					return 0;
+				}
+				if (!_writeByte((address << 1) | 1)) {
+					_stop();
+					return 0;
+				}
+				while (_rxLength < length) {
+					// ACK all bytes but last one
+					if (!_readByte(&_buffer[_rxLength], _rxLength + 1 < length)) {
+						_rxLength = 0;
+						break;
+					}
+					_rxLength++;
+				}
+				if (stop && !_stop()) {
+					_rxLength = 0;
+				}
+				return _rxLength;
+			}
+
+			/**
+			 * \brief Returns next received byte
+			 *
+			 * @return Byte, -1 if there's no more
+			 */
+			int read() {
+				return _rxIndex < _rxLength ? _buffer[_rxIndex++] : -1;
+			}
+
+			/**
+			 * \brief Returns received bytes not read yet
+			 *
+			 * @return Bytes available
+			 */
+			int available() {
+				return _rxLength - _rxIndex;
+			}
+
+		private:
+			uint8_t _buffer[URTCLIB_SOFTWIRE_BUFFER];
+			uint8_t _address = 0;
+			uint8_t _txLength = 0;
+			uint8_t _rxLength = 0;
+			uint8_t _rxIndex = 0;
+			uint16_t _low = 5;
+			uint16_t _high = 5;
+			bool _overflow = false;
+			bool _stuck = false;
+			#ifdef URTCLIB_SOFTWIRE_PORTS
+			volatile uRTCLibSoftWireReg *_sdaMode;
+			volatile uRTCLibSoftWireReg *_sdaIn;
+			volatile uRTCLibSoftWireReg *_sclMode;
+			volatile uRTCLibSoftWireReg *_sclIn;
+			uRTCLibSoftWireReg _sdaMask;
+			uRTCLibSoftWireReg _sclMask;
+
+			inline void _sdaLow() { *_sdaMode |= _sdaMask; }
+			inline void _sdaRelease() { *_sdaMode &= ~_sdaMask; }
+			inline bool _sdaRead() { return *_sdaIn & _sdaMask; }
+			inline void _sclLow() { *_sclMode |= _sclMask; }
+			inline void _sclRelease() { *_sclMode &= ~_sclMask; }
+			inline bool _sclRead() { return *_sclIn & _sclMask; }
+			#else
+			inline void _sdaLow() { pinMode(SDA_PIN, OUTPUT); }
+			inline void _sdaRelease() { pinMode(SDA_PIN, INPUT); }
+			inline bool _sdaRead() { return digitalRead(SDA_PIN); }
+			inline void _sclLow() { pinMode(SCL_PIN, OUTPUT); }
+			inline void _sclRelease() { pinMode(SCL_PIN, INPUT); }
+			inline bool _sclRead() { return digitalRead(SCL_PIN); }
+			#endif
+
+			/**
+			 * \brief Releases SCL and waits while slave stretches it
+			 *
+			 * @return False on timeout
+			 */
+			bool _sclHigh() {
+				unsigned long start;
+				_sclRelease();
+				if (_sclRead()) {
+					return true;
+				}
+				start = micros();
+				while (!_sclRead()) {
+					if (micros() - start > URTCLIB_SOFTWIRE_STRETCH_US) {
+						_stuck = true;
+						return false;
+					}
+				}
+				return true;
+			}
+
+			/**
+			 * \brief Start or repeated start condition, leaves SCL low
+			 *
+			 * @return False if bus is stuck
+			 */
+			bool _start() {
+				_stuck = false;
+				_sdaRelease();
+				delayMicroseconds(_low);
+				if (!_sclHigh()) {
+					return false;
+				}
+				delayMicroseconds(_high);
+				if (!_sdaRead()) { // Other master or slave holding SDA
+					_stuck = true;
+					return false;
+				}
+				_sdaLow();
+				delayMicroseconds(_high);
+				_sclLow();
+				return true;
+			}
+
+			/**
+			 * \brief Stop condition, leaves bus free
+			 *
+			 * @return False if bus is stuck
+			 */
+			bool _stop() {
+				bool ret;
+				_sdaLow();
+				delayMicroseconds(_low);
+				ret = _sclHigh();
+				delayMicroseconds(_high);
+				_sdaRelease();
+				delayMicroseconds(_low); // Bus free time
+				return ret;
+			}
+
+			/**
+			 * \brief Sends a byte, SCL low on entry and exit
+			 *
+			 * @param data Byte to send
+			 *
+			 * @return True if slave acknowledged it
+			 */
+			bool _writeByte(uint8_t data) {
+				uint8_t i;
+				bool ack;
+				for (i = 0; i < 8; i++) {
+					if (data & 0b10000000) {
+						_sdaRelease();
+					} else {
+						_sdaLow();
+					}
+					data <<= 1;
+					delayMicroseconds(_low);
+					if (!_sclHigh()) {
+						return false;
+					}
+					delayMicroseconds(_high);
+					_sclLow();
+				}
+				_sdaRelease();
+				delayMicroseconds(_low);
+				if (!_sclHigh()) {
+					return false;
+				}
+				delayMicroseconds(_high);
+				ack = !_sdaRead();
+				_sclLow();
+				return ack;
+			}
+
+			/**
+			 * \brief Receives a byte, SCL low on entry and exit
+			 *
+			 * @param data Where to store received byte
+			 * @param ack Acknowledge it, false on last byte
+			 *
+			 * @return False if bus is stuck
+			 */
+			bool _readByte(uint8_t *data, const bool ack) {
+				uint8_t i, value = 0;
+				_sdaRelease();
+				for (i = 0; i < 8; i++) {
+					delayMicroseconds(_low);
+					if (!_sclHigh()) {
+						return false;
+					}
+					delayMicroseconds(_high);
+					value = (value << 1) | (_sdaRead() ? 1 : 0);
+					_sclLow();
+				}
+				if (ack) {
+					_sdaLow();
+				}
+				delayMicroseconds(_low);
+				if (!_sclHigh()) {
+					return false;
+				}
+				delayMicroseconds(_high);
+				_sclLow();
+				_sdaRelease();
+				*data = value;
+				return true;
+			}
+	};
+
+#endif
@@ -0,0 +1,382 @@
+/**
+ * \class uRTCLibTimezone
+ * \brief Local time from RTC kept in UTC, with POSIX TZ string rules
+ *
+ * Both transition instants of a year are computed once, lazily, when a time of another year is converted; any other
+ * conversion is only a couple of comparisons.
+ *
+ * @file uRTCLibTimezone.cpp
+ * @copyright Naguissa
+ * @author Naguissa
+ * @see <a href="https://github.com/Naguissa/uRTCLib">https://github.com/Naguissa/uRTCLib</a>
+ * @see <a href="mailto:naguissa@foroelectro.net">naguissa@foroelectro.net</a>
+ * @version 6.9.9
+ */
+#include <Arduino.h>
+#include "uRTCLibTimezone.h"
+
+/**
+ * \brief Constructor
+ *
+ * Timezone is UTC until begin() is called.
+ *
+ * @param rtc uRTCLib instance, with RTC in UTC
+ */
+uRTCLibTimezone::uRTCLibTimezone(uRTCLib &rtc) {
+	_rtc = &rtc;
+}
+
+/**
+ * \brief Sets timezone from a POSIX TZ string
+ *
+ * @param tz TZ string, i.e. "CET-1CEST,M3.5.0,M10.5.0/3"
+ *
+ * @return False on unsupported or wrong string; timezone is left as UTC
+ */
+bool uRTCLibTimezone::begin(const char *tz) {
+	const char *p = tz;
+	int32_t value, std, dst;
+	uRTCLibTzRule rule[2] = { { 'M', 3, 2, 0, 0, 7200L }, { 'M', 11, 1, 0, 0, 7200L } }; // US rules by default
+	_std = 0;
+	_hasDst = false;
+	_yearStart = 0; // Forces transitions reload
+	_yearEnd = 0;
+	if (!_parseName(&p) || !_parseTime(&p, &value)) {
+		return false;
+	}
+	std = -value; // POSIX offsets are positive west of Greenwich
+	if (*p == 0) {
+		_std = std;
+		return true;
+	}
+	if (!_parseName(&p)) {
+		return false;
+	}
+	dst = std + 3600L;
+	if (*p != 0 && *p != ',') {
+		if (!_parseTime(&p, &value)) {
+			return false;
+		}
+		dst = -value;
+	}
+	if (*p == ',') {
+		p++;
+		if (!_parseRule(&p, &rule[0]) || *p != ',') {
+			return false;
+		}
+		p++;
+		if (!_parseRule(&p, &rule[1])) {
+			return false;
+		}
+	}
+	if (*p != 0) {
+		return false;
+	}
+	_std = std;
+	_dst = dst;
+	_rule[0] = rule[0];
+	_rule[1] = rule[1];
+	_hasDst = true;
+	return true;
+}
+
+/**
+ * \brief Returns local time of cached RTC time
+ *
+ * No I2C access, call uRTCLib::refresh() before.
+ *
+ * @return Local time as UNIX timestamp
+ */
+uint32_t uRTCLibTimezone::now() {
+	return toLocal(_rtc->epoch());
+}
+
+/**
+ * \brief Converts UTC to local time
+ *
+ * @param utc UNIX timestamp
+ *
+ * @return Local time as UNIX timestamp
+ */
+uint32_t uRTCLibTimezone::toLocal(const uint32_t utc) {
+	return utc + offset(utc);
+}
+
+/**
+ * \brief Converts local time to UTC
+ *
+ * Repeated local times when DST ends are taken as DST; skipped ones when it starts are taken as standard time.
+ *
+ * @param local Local time as UNIX timestamp
+ *
+ * @return UNIX timestamp
+ */
+uint32_t uRTCLibTimezone::toUtc(const uint32_t local) {
+	if (_hasDst && dst(local - _dst)) {
+		return local - _dst;
+	}
+	return local - _std;
+}
+
+/**
+ * \brief Returns UTC offset
+ *
+ * @param utc UNIX timestamp
+ *
+ * @return Offset in seconds, positive east of Greenwich (local = UTC + offset)
+ */
+int32_t uRTCLibTimezone::offset(const uint32_t utc) {
+	return dst(utc) ? _dst : _std;
+}
+
+/**
+ * \brief Checks if DST is in effect
+ *
+ * @param utc UNIX timestamp
+ *
+ * @return True on DST
+ */
+bool uRTCLibTimezone::dst(const uint32_t utc) {
+	if (!_hasDst) {
+		return false;
+	}
+	if (utc < _yearStart || utc >= _yearEnd) {
+		_load(utc);
+	}
+	if (_start < _end) {
+		return utc >= _start && utc < _end;
+	}
+	// Southern hemisphere, DST spans new year
+	return utc >= _start || utc < _end;
+}
+
+/**
+ * \brief Returns DST start of last converted year
+ *
+ * @return UNIX timestamp, 0 if timezone has no DST
+ */
+uint32_t uRTCLibTimezone::dstStart() {
+	return _hasDst ? _start : 0;
+}
+
+/**
+ * \brief Returns DST end of last converted year
+ *
+ * @return UNIX timestamp, 0 if timezone has no DST
+ */
+uint32_t uRTCLibTimezone::dstEnd() {
+	return _hasDst ? _end : 0;
+}
+
+/**
+ * \brief Computes transitions of the year of a timestamp
+ *
+ * @param utc UNIX timestamp
+ */
+void uRTCLibTimezone::_load(const uint32_t utc) {
+	uint32_t days = utc / 86400UL;
+	uint16_t year = 1970 + days / 366;
+	while (_days(year + 1, 1, 1) <= days) {
+		year++;
+	}
+	_yearStart = _days(year, 1, 1) * 86400UL;
+	_yearEnd = year < 2106 ? _days(year + 1, 1, 1) * 86400UL : 0xFFFFFFFFUL;
+	// Start time is given in standard time, end time in DST
+	_start = _ruleDay(_rule[0], year) * 86400UL + _rule[0].time - _std;
+	_end = _ruleDay(_rule[1], year) * 86400UL + _rule[1].time - _dst;
+}
+
+/**
+ * \brief Days since 1970-01-01
+ *
+ * @param year Full year
+ * @param month Month, 1 to 12
+ * @param day Day of month
+ *
+ * @return Days
+ */
+uint32_t uRTCLibTimezone::_days(const uint16_t year, const uint8_t month, const uint8_t day) {
+	uint16_t y = year - 1;
+	// Leap days since 1970 and days before month (31 days months and February as 30 by formula, then adjusted)
+	return (year - 1970) * 365UL + (y / 4 - y / 100 + y / 400 - 477) + (367U * month - 362) / 12 - (month > 2 ? (_leap(year) ? 1 : 2) : 0) + day - 1;
+}
+
+/**
+ * \brief Checks leap year
+ *
+ * @param year Full year
+ *
+ * @return True on leap year
+ */
+bool uRTCLibTimezone::_leap(const uint16_t year) {
+	return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+/**
+ * \brief Day of a transition rule
+ *
+ * @param rule Transition rule
+ * @param year Full year
+ *
+ * @return Days since 1970-01-01
+ */
+uint32_t uRTCLibTimezone::_ruleDay(const uRTCLibTzRule &rule, const uint16_t year) {
+	uint32_t first;
+	uint8_t length, day;
+	switch (rule.type) {
+		case 'J':
+			return _days(year, 1, 1) + rule.day - 1 + (_leap(year) && rule.day >= 60 ? 1 : 0);
+
+		case 'n':
+			return _days(year, 1, 1) + rule.day;
+
+		// case 'M':
+		default:
+			first = _days(year, rule.month, 1);
+			length = (rule.month == 12 ? _days(year + 1, 1, 1) : _days(year, rule.month + 1, 1)) - first;
+			// 1970-01-01 was Thursday
+			day = (rule.dow + 7 - (first + 4) % 7) % 7 + (rule.week - 1) * 7;
+			while (day >= length) { // Week 5, last one
+				day -= 7;
+			}
+			return first + day;
+	}
+}
+
+/**
+ * \brief Parses a decimal number
+ *
+ * @param p String position, advanced
+ * @param value Number
+ *
+ * @return False if there's no number or it's bigger than 999
+ */
+bool uRTCLibTimezone::_parseNumber(const char **p, uint16_t *value) {
+	const char *s = *p;
+	*value = 0;
+	while (*s >= '0' && *s <= '9' && *value < 1000) {
+		*value = *value * 10 + (*s++ - '0');
+	}
+	if (s == *p || *value >= 1000) {
+		return false;
+	}
+	*p = s;
+	return true;
+}
+
+/**
+ * \brief Parses a timezone name, 3 or more letters or quoted as <...>
+ *
+ * @param p String position, advanced
+ *
+ * @return False on error
+ */
+bool uRTCLibTimezone::_parseName(const char **p) {
+	const char *s = *p;
+	if (*s == '<') {
+		while (*s != 0 && *s != '>') {
+			s++;
+		}
+		if (*s != '>') {
+			return false;
+		}
+		*p = s + 1;
+		return true;
+	}
+	while ((*s >= 'A' && *s <= 'Z') || (*s >= 'a' && *s <= 'z')) {
+		s++;
+	}
+	if (s - *p < 3) {
+		return false;
+	}
+	*p = s;
+	return true;
+}
+
+/**
+ * \brief Parses an offset or a rule time, [+-]hh[:mm[:ss]]
+ *
+ * @param p String position, advanced
+ * @param seconds Parsed value
+ *
+ * @return False on error
+ */
+bool uRTCLibTimezone::_parseTime(const char **p, int32_t *seconds) {
+	const char *s = *p;
+	bool negative = false;
+	uint16_t part;
+	uint8_t fields = 0;
+	int32_t value = 0;
+	if (*s == '+' || *s == '-') {
+		negative = *s == '-';
+		s++;
+	}
+	while (fields < 3) {
+		if (!_parseNumber(&s, &part) || (fields == 0 ? part > 167 : part > 59)) {
+			return false;
+		}
+		value = value * 60 + part;
+		fields++;
+		if (*s != ':') {
+			break;
+		}
+		s++;
+	}
+	while (fields++ < 3) {
+		value *= 60;
+	}
+	*seconds = negative ? -value : value;
+	*p = s;
+	return true;
+}
+
+/**
+ * \brief Parses a transition rule, Mm.w.d, Jn or n, with optional /time
+ *
+ * @param p String position, advanced
+ * @param rule Parsed rule
+ *
+ * @return False on error
+ */
+bool uRTCLibTimezone::_parseRule(const char **p, uRTCLibTzRule *rule) {
+	const char *s = *p;
+	uint16_t month, week, dow;
+	rule->type = *s;
+	switch (*s) {
+		case 'M':
+			s++;
+			if (!_parseNumber(&s, &month) || *s++ != '.' || !_parseNumber(&s, &week) || *s++ != '.' || !_parseNumber(&s, &dow)) {
+				return false;
+			}
+			if (month < 1 || month > 12 || week < 1 || week > 5 || dow > 6) {
+				return false;
+			}
+			rule->month = month;
+			rule->week = week;
+			rule->dow = dow;
+			break;
+
+		case 'J':
+			s++;
+			if (!_parseNumber(&s, &rule->day) || rule->day < 1 || rule->day > 365) {
+				return false;
+			}
+			break;
+
+		default:
+			rule->type = 'n';
+			if (!_parseNumber(&s, &rule->day) || rule->day > 365) {
+				return false;
+			}
+			break;
+	}
+	rule->time = 7200L;
+	if (*s == '/') {
+		s++;
+		if (!_parseTime(&s, &rule->time)) {
+			return false;
+		}
+	}
+	*p = s;
+	return true;
+}
@@ -0,0 +1,160 @@
+/**
+ * \class uRTCLibTimezone
+ * \brief Local time from RTC kept in UTC, with POSIX TZ string rules
+ *
+ * Supported TZ subset: std offset [dst [offset] [,start[/time],end[/time]]]
+ *  - Names: 3 or more letters, or quoted as <+03>
+ *  - Offsets: [+-]hh[:mm[:ss]], positive west of Greenwich as POSIX (CET-1 is UTC+1). DST defaults to 1 hour ahead.
+ *  - Rules: Mm.w.d (week 5 is last one, day 0 is Sunday), Jn (1 to 365, February 29th never counted) or n (0 to 365).
+ *    Time defaults to 02:00:00, can be negative or bigger than 24 hours. Without rules current US ones are used (M3.2.0,M11.1.0).
+ *
+ * Examples: "CET-1CEST,M3.5.0,M10.5.0/3", "EST5EDT,M3.2.0,M11.1.0", "<-03>3", "AEST-10AEDT,M10.1.0,M4.1.0/3"
+ *
+ * Both transition instants of a year are computed once, lazily, when a time of another year is converted; any other
+ * conversion is only a couple of comparisons. RTC is not accessed, now() uses cached data from last refresh().
+ * Valid from 1970 to 2105.
+ *
+ * @file uRTCLibTimezone.h
+ * @copyright Naguissa
+ * @author Naguissa
+ * @see <a href="https://github.com/Naguissa/uRTCLib">https://github.com/Naguissa/uRTCLib</a>
+ * @see <a href="mailto:naguissa@foroelectro.net">naguissa@foroelectro.net</a>
+ * @version 6.9.9
+ */
+#ifndef URTCLIBTIMEZONE
+	/**
+	 * \brief Prevent multiple inclussion
+	 */
+	#define URTCLIBTIMEZONE
+	#include "Arduino.h"
+	#include "uRTCLib.h"
+
+
+	/**
+	 * \brief DST transition rule, parsed from TZ string
+	 */
+	struct uRTCLibTzRule {
+		/**
+		 * \brief Rule type: 'M' month, week and day; 'J' julian day without February 29th; 'n' zero based day of year
+		 */
+		char type;
+		/**
+		 * \brief Month, 1 to 12 ('M' rules)
+		 */
+		uint8_t month;
+		/**
+		 * \brief Week of month, 1 to 5; 5 is last one ('M' rules)
+		 */
+		uint8_t week;
+		/**
+		 * \brief Day of week, 0 is Sunday ('M' rules)
+		 */
+		uint8_t dow;
+		/**
+		 * \brief Day of year ('J' and 'n' rules)
+		 */
+		uint16_t day;
+		/**
+		 * \brief Local time of transition, seconds after midnight
+		 */
+		int32_t time;
+	};
+
+
+	class uRTCLibTimezone {
+		public:
+			/**
+			 * \brief Constructor
+			 *
+			 * Timezone is UTC until begin() is called.
+			 *
+			 * @param rtc uRTCLib instance, with RTC in UTC
+			 */
+			uRTCLibTimezone(uRTCLib &);
+			/**
+			 * \brief Sets timezone from a POSIX TZ string
+			 *
+			 * @param tz TZ string, i.e. "CET-1CEST,M3.5.0,M10.5.0/3"
+			 *
+			 * @return False on unsupported or wrong string; timezone is left as UTC
+			 */
+			bool begin(const char *);
+			/**
+			 * \brief Returns local time of cached RTC time
+			 *
+			 * No I2C access, call uRTCLib::refresh() before.
+			 *
+			 * @return Local time as UNIX timestamp
+			 */
+			uint32_t now();
+			/**
+			 * \brief Converts UTC to local time
+			 *
+			 * @param utc UNIX timestamp
+			 *
+			 * @return Local time as UNIX timestamp
+			 */
+			uint32_t toLocal(const uint32_t);
+			/**
+			 * \brief Converts local time to UTC
+			 *
+			 * Repeated local times when DST ends are taken as DST; skipped ones when it starts are taken as standard time.
+			 *
+			 * @param local Local time as UNIX timestamp
+			 *
+			 * @return UNIX timestamp
+			 */
+			uint32_t toUtc(const uint32_t);
+			/**
+			 * \brief Returns UTC offset
+			 *
+			 * @param utc UNIX timestamp
+			 *
+			 * @return Offset in seconds, positive east of Greenwich (local = UTC + offset)
+			 */
+			int32_t offset(const uint32_t);
+			/**
+			 * \brief Checks if DST is in effect
+			 *
+			 * @param utc UNIX timestamp
+			 *
+			 * @return True on DST
+			 */
+			bool dst(const uint32_t);
+			/**
+			 * \brief Returns DST start of last converted year
+			 *
+			 * @return UNIX timestamp, 0 if timezone has no DST
+			 */
+			uint32_t dstStart();
+			/**
+			 * \brief Returns DST end of last converted year
+			 *
+			 * @return UNIX timestamp, 0 if timezone has no DST
+			 */
+			uint32_t dstEnd();
+
+		private:
+			uRTCLib *_rtc;
+			int32_t _std = 0;
+			int32_t _dst = 0;
+			bool _hasDst = false;
+			uRTCLibTzRule _rule[2];
+
+			// Transitions cache, UTC
+			uint32_t _yearStart = 0;
+			uint32_t _yearEnd = 0;
+			uint32_t _start = 0;
+			uint32_t _end = 0;
+
+			void _load(const uint32_t);
+			static uint32_t _days(const uint16_t, const uint8_t, const uint8_t);
+			static bool _leap(const uint16_t);
+			static uint32_t _ruleDay(const uRTCLibTzRule &, const uint16_t);
+			static bool _parseNumber(const char **, uint16_t *);
+			static bool _parseName(const char **);
+			static bool _parseTime(const char **, int32_t *);
+			static bool _parseRule(const char **, uRTCLibTzRule *);
+	};
+
+#endif